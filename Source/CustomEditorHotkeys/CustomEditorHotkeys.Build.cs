@@ -40,9 +40,20 @@ public class CustomEditorHotkeys : ModuleRules
 				"LevelEditor",
 				"ContentBrowser",
 				"EditorStyle",
-				"BlueprintGraph"
+				"BlueprintGraph",
+				"DeveloperSettings",
+				"Sockets",
+				"Networking",
+				"DirectoryWatcher",
+				"Json",
+				"EditorSubsystem",
+				"PropertyEditor",
+				"WorkspaceMenuStructure"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
+
+		// Python script commands are optional, only the interface header is used and the module is loaded at runtime when enabled
+		PrivateIncludePathModuleNames.Add("PythonScriptPlugin");
 	}
 }
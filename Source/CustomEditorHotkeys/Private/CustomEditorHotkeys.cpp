@@ -3,6 +3,16 @@
 #include "CustomEditorHotkeys.h"
 #include "CustomEditorHotkeysStyle.h"
 #include "CustomEditorHotkeysCommands.h"
+#include "CustomEditorHotkeysSelectionTracker.h"
+#include "CustomEditorHotkeysRemoteTrigger.h"
+#include "CustomEditorHotkeysSettings.h"
+#include "CustomEditorHotkeysMacros.h"
+#include "CustomEditorHotkeysPythonScripts.h"
+#include "CustomEditorHotkeysDispatch.h"
+#include "CustomEditorHotkeysProfiles.h"
+#include "SCustomEditorHotkeysParameterPanel.h"
+#include "CustomEditorHotkeysRegistryTags.h"
+#include "Editor.h"
 #include "Misc/MessageDialog.h"
 #include "ToolMenus.h"
 #include "LevelEditor.h"
@@ -20,9 +30,12 @@ void FCustomEditorHotkeysModule::StartupModule()
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
 	
 	FCustomEditorHotkeysStyle::Initialize();
-	FCustomEditorHotkeysStyle::ReloadTextures();
 	
 	FCustomEditorHotkeysCommands::Register();
+	FCustomEditorHotkeysSelectionTracker::Initialize();
+	FCustomEditorHotkeysPythonScripts::Initialize();
+	SCustomEditorHotkeysParameterPanel::RegisterTabSpawner();
+	FCustomEditorHotkeysRegistryTags::Register();
 
 	PluginCommands = MakeShareable(new FUICommandList);
 	CustomLevelEditorCommands = MakeShareable(new FUICommandList);
@@ -33,6 +46,12 @@ void FCustomEditorHotkeysModule::StartupModule()
 		FExecuteAction::CreateRaw(this, &FCustomEditorHotkeysModule::PluginButtonClicked),
 		FCanExecuteAction());
 
+	PluginCommands->MapAction(
+		FCustomEditorHotkeysCommands::Get().ToggleMacroRecording,
+		FExecuteAction::CreateRaw(this, &FCustomEditorHotkeysModule::ToggleMacroRecording),
+		FCanExecuteAction(),
+		FIsActionChecked::CreateStatic(&FCustomEditorHotkeysMacros::IsRecording));
+
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::Get().LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
 	AssetRegistryInitialLoadCompleteDelegateHandle = AssetRegistry.OnFilesLoaded().AddLambda([this, &AssetRegistry] {
@@ -49,6 +68,14 @@ void FCustomEditorHotkeysModule::StartupModule()
 	FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"));
 	ContentBrowserModule.GetAllContentBrowserCommandExtenders().Add(FContentBrowserCommandExtender::CreateRaw(this, &FCustomEditorHotkeysModule::OnExtendContentBrowserCommands));
 	ContentBrowserCommandExtenderDelegateHandle = ContentBrowserModule.GetAllContentBrowserCommandExtenders().Last().GetHandle();
+
+	if (GEditor)
+	{
+		BlueprintCompiledDelegateHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FCustomEditorHotkeysModule::OnBlueprintCompiled);
+	}
+
+	SettingsChangedDelegateHandle = GetMutableDefault<UCustomEditorHotkeysSettings>()->OnSettingChanged().AddRaw(this, &FCustomEditorHotkeysModule::OnSettingsChanged);
+	FCustomEditorHotkeysRemoteTrigger::Initialize();
 }
 
 void FCustomEditorHotkeysModule::ShutdownModule()
@@ -62,6 +89,26 @@ void FCustomEditorHotkeysModule::ShutdownModule()
 
 	FCustomEditorHotkeysStyle::Shutdown();
 
+	FCustomEditorHotkeysSelectionTracker::Shutdown();
+
+	FCustomEditorHotkeysRemoteTrigger::Shutdown();
+
+	FCustomEditorHotkeysPythonScripts::Shutdown();
+	SCustomEditorHotkeysParameterPanel::UnregisterTabSpawner();
+	FCustomEditorHotkeysRegistryTags::Unregister();
+
+	FTSTicker::GetCoreTicker().RemoveTicker(DeferredRefreshTickerHandle);
+
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledDelegateHandle);
+	}
+
+	if (UObjectInitialized())
+	{
+		GetMutableDefault<UCustomEditorHotkeysSettings>()->OnSettingChanged().Remove(SettingsChangedDelegateHandle);
+	}
+
 	for (const TPair<FName, TSharedPtr<FUICommandInfo>>& Command : FCustomEditorHotkeysCommands::Get().CustomLevelEditorCommands)
 	{
 		CustomLevelEditorCommands->UnmapAction(Command.Value);
@@ -72,10 +119,18 @@ void FCustomEditorHotkeysModule::ShutdownModule()
 		CustomContentBrowserCommands->UnmapAction(Command.Value);
 	}
 
+	for (const TPair<FName, TSharedPtr<FUICommandInfo>>& Command : FCustomEditorHotkeysCommands::Get().CustomMacroCommands)
+	{
+		CustomLevelEditorCommands->UnmapAction(Command.Value);
+		CustomContentBrowserCommands->UnmapAction(Command.Value);
+	}
+
 	FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"));
 	ContentBrowserModule.GetAllContentBrowserCommandExtenders().RemoveAll([this](const FContentBrowserCommandExtender& Delegate) { return Delegate.GetHandle() == ContentBrowserCommandExtenderDelegateHandle; });
 
 
+	FCustomEditorHotkeysBlutilityExtensions::ReleaseCaches();
+
 	FCustomEditorHotkeysCommands::Unregister();
 }
 
@@ -84,6 +139,17 @@ void FCustomEditorHotkeysModule::PluginButtonClicked()
 	ResetEditorCommands();
 }
 
+/** Python script commands run their script function, every other custom command goes through the utility dispatch */
+static FExecuteAction MakeCustomCommandAction(FName CommandName, void(*ExecuteUtilityFunction)(FName))
+{
+	if (FCustomEditorHotkeysPythonScripts::IsInitialized() && FCustomEditorHotkeysPythonScripts::Get().FindEntryPoint(CommandName))
+	{
+		return FExecuteAction::CreateStatic(&FCustomEditorHotkeysPythonScripts::ExecuteScriptCommandByName, CommandName);
+	}
+
+	return FExecuteAction::CreateStatic(ExecuteUtilityFunction, CommandName);
+}
+
 void FCustomEditorHotkeysModule::ResetEditorCommands()
 {
 	if (FCustomEditorHotkeysCommands::IsRegistered())
@@ -105,6 +171,12 @@ void FCustomEditorHotkeysModule::ResetEditorCommands()
 			}
 		}
 
+		for (const auto& Pair : FCustomEditorHotkeysCommands::GetCustomMacroCommands())
+		{
+			CustomLevelEditorCommands->UnmapAction(Pair.Value);
+			CustomContentBrowserCommands->UnmapAction(Pair.Value);
+		}
+
 		FCustomEditorHotkeysCommands::GetMutable().RegisterCustomCommands();
 
 		// Remap
@@ -112,8 +184,7 @@ void FCustomEditorHotkeysModule::ResetEditorCommands()
 		{
 			if (!CustomLevelEditorCommands->IsActionMapped(Pair.Value))
 			{
-				CustomLevelEditorCommands->MapAction(Pair.Value,
-					FExecuteAction::CreateStatic(&FCustomEditorHotkeysBlutilityExtensions::ExecuteActorUtilityFunctionByName, Pair.Key));
+				CustomLevelEditorCommands->MapAction(Pair.Value, MakeCustomCommandAction(Pair.Key, &FCustomEditorHotkeysBlutilityExtensions::ExecuteActorUtilityFunctionByName));
 			}
 			else
 			{
@@ -125,14 +196,44 @@ void FCustomEditorHotkeysModule::ResetEditorCommands()
 		{
 			if (!CustomContentBrowserCommands->IsActionMapped(Pair.Value))
 			{
-				CustomContentBrowserCommands->MapAction(Pair.Value,
-					FExecuteAction::CreateStatic(&FCustomEditorHotkeysBlutilityExtensions::ExecuteAssetUtilityFunctionByName, Pair.Key));
+				CustomContentBrowserCommands->MapAction(Pair.Value, MakeCustomCommandAction(Pair.Key, &FCustomEditorHotkeysBlutilityExtensions::ExecuteAssetUtilityFunctionByName));
 			}
 			else
 			{
 				UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Duplicate Custom Command mapping found: \"%s\""), *Pair.Key.ToString());
 			}
 		}
+
+		// Macros can mix level editor and content browser steps, so they're reachable from both
+		const TArray<FCustomEditorHotkeysMacro>& Macros = GetDefault<UCustomEditorHotkeysSettings>()->Macros;
+		for (const auto& Pair : FCustomEditorHotkeysCommands::GetCustomMacroCommands())
+		{
+			const FCustomEditorHotkeysMacro* Macro = Macros.FindByPredicate([&Pair](const FCustomEditorHotkeysMacro& Candidate) { return FCustomEditorHotkeysMacros::GetMacroCommandName(Candidate.Name) == Pair.Key; });
+			if (Macro)
+			{
+				const FExecuteAction ReplayAction = FExecuteAction::CreateStatic(static_cast<void(*)(FName)>(&FCustomEditorHotkeysMacros::ReplayMacro), Macro->Name);
+				CustomLevelEditorCommands->MapAction(Pair.Value, ReplayAction);
+				CustomContentBrowserCommands->MapAction(Pair.Value, ReplayAction);
+			}
+		}
+
+		// Chords shared with other commands only run one of them, report every clash in one go
+		TArray<FCustomEditorHotkeysProfiles::FChordConflict> Conflicts;
+		FCustomEditorHotkeysProfiles::FindConflicts(Conflicts);
+		FCustomEditorHotkeysProfiles::LogConflicts(Conflicts);
+	}
+}
+
+void FCustomEditorHotkeysModule::ToggleMacroRecording()
+{
+	if (!FCustomEditorHotkeysMacros::IsRecording())
+	{
+		FCustomEditorHotkeysMacros::StartRecording();
+	}
+	else if (!FCustomEditorHotkeysMacros::StopRecording().IsNone())
+	{
+		// Register the new macro so it shows up in the keyboard shortcut preferences straight away
+		ResetEditorCommands();
 	}
 }
 
@@ -146,6 +247,7 @@ void FCustomEditorHotkeysModule::RegisterMenus()
 		{
 			FToolMenuSection& Section = Menu->FindOrAddSection("Hotkeys");
 			Section.AddMenuEntryWithCommandList(FCustomEditorHotkeysCommands::Get().PluginAction, PluginCommands);
+			Section.AddMenuEntryWithCommandList(FCustomEditorHotkeysCommands::Get().ToggleMacroRecording, PluginCommands);
 		}
 	}
 
@@ -161,10 +263,52 @@ void FCustomEditorHotkeysModule::RegisterMenus()
 	}
 }
 
+void FCustomEditorHotkeysModule::OnSettingsChanged(UObject* Settings, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	const FName PropertyName = PropertyChangedEvent.GetMemberPropertyName();
+
+	// Restarting the listener drops connected clients, so only do it when its own settings changed (or we can't tell which did)
+	if (PropertyName.IsNone()
+		|| PropertyName == GET_MEMBER_NAME_CHECKED(UCustomEditorHotkeysSettings, bEnableRemoteTrigger)
+		|| PropertyName == GET_MEMBER_NAME_CHECKED(UCustomEditorHotkeysSettings, RemoteTriggerPort)
+		|| PropertyName == GET_MEMBER_NAME_CHECKED(UCustomEditorHotkeysSettings, MaxRemoteRequestsPerTick))
+	{
+		FCustomEditorHotkeysRemoteTrigger::Initialize();
+	}
+
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(UCustomEditorHotkeysSettings, LevelEditorPythonScriptDirectories)
+		|| PropertyName == GET_MEMBER_NAME_CHECKED(UCustomEditorHotkeysSettings, ContentBrowserPythonScriptDirectories))
+	{
+		FCustomEditorHotkeysPythonScripts::Initialize();
+		ResetEditorCommands();
+	}
+}
+
+void FCustomEditorHotkeysModule::OnBlueprintCompiled()
+{
+	TSharedPtr<const FCustomEditorHotkeysDispatchTable> LevelEditorDispatchTable = FCustomEditorHotkeysCommands::GetLevelEditorDispatchTable();
+	TSharedPtr<const FCustomEditorHotkeysDispatchTable> ContentBrowserDispatchTable = FCustomEditorHotkeysCommands::GetContentBrowserDispatchTable();
+
+	const bool bHasStaleOverloads = (LevelEditorDispatchTable.IsValid() && LevelEditorDispatchTable->HasStaleOverloads())
+		|| (ContentBrowserDispatchTable.IsValid() && ContentBrowserDispatchTable->HasStaleOverloads());
+
+	// Refresh once the compile has fully finished, a batch of recompiled utilities only refreshes once
+	if (bHasStaleOverloads && !DeferredRefreshTickerHandle.IsValid())
+	{
+		DeferredRefreshTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float DeltaTime)
+			{
+				DeferredRefreshTickerHandle.Reset();
+				ResetEditorCommands();
+				return false;
+			}));
+	}
+}
+
 void FCustomEditorHotkeysModule::OnExtendContentBrowserCommands(TSharedRef<FUICommandList> CommandList, FOnContentBrowserGetSelection GetSelectionDelegate)
 {
-	CommandList->Append(CustomContentBrowserCommands->AsShared());
-	UE_LOG(LogCustomEditorHotkeys, Log, TEXT("Custom commands appended to content browser module."));
+	// Append adds our list as a unique child, a browser asking for its extenders again doesn't get a second copy
+	CommandList->Append(CustomContentBrowserCommands.ToSharedRef());
+	UE_LOG(LogCustomEditorHotkeys, Verbose, TEXT("Custom commands appended to a content browser."));
 }
 
 #undef LOCTEXT_NAMESPACE
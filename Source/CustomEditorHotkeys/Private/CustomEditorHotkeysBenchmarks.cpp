@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CustomEditorHotkeys.h"
+#include "CustomEditorHotkeysCommands.h"
+#include "HAL/IConsoleManager.h"
+#include "ActorActionUtility.h"
+#include "AssetActionUtility.h"
+
+static FAutoConsoleCommand BenchmarkRefreshCommand(
+	TEXT("CustomEditorHotkeys.Benchmark.Refresh"),
+	TEXT("Refreshes the custom editor hotkeys repeatedly and logs the time spent in each phase. Usage: CustomEditorHotkeys.Benchmark.Refresh [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10;
+
+			FCustomEditorHotkeysModule& Module = FModuleManager::GetModuleChecked<FCustomEditorHotkeysModule>(TEXT("CustomEditorHotkeys"));
+
+			double MinSeconds = TNumericLimits<double>::Max();
+			double MaxSeconds = 0.0;
+			double TotalSeconds = 0.0;
+			FCustomEditorHotkeysCommands::FRefreshStats PhaseTotals;
+
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				Module.PluginButtonClicked();
+				const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+				MinSeconds = FMath::Min(MinSeconds, Seconds);
+				MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+				TotalSeconds += Seconds;
+
+				const FCustomEditorHotkeysCommands::FRefreshStats& Stats = FCustomEditorHotkeysCommands::GetLastRefreshStats();
+				PhaseTotals.NumUtilityFunctions = Stats.NumUtilityFunctions;
+				PhaseTotals.NumTaggedFunctions = Stats.NumTaggedFunctions;
+				PhaseTotals.NumCommands = Stats.NumCommands;
+				PhaseTotals.GatherSeconds += Stats.GatherSeconds;
+				PhaseTotals.DispatchSeconds += Stats.DispatchSeconds;
+				PhaseTotals.RegisterSeconds += Stats.RegisterSeconds;
+			}
+
+			UE_LOG(LogCustomEditorHotkeys, Display, TEXT("Refresh of %d commands (%d utility functions, %d from registry tags) over %d iterations: avg %.3f ms, min %.3f ms, max %.3f ms"),
+				PhaseTotals.NumCommands, PhaseTotals.NumUtilityFunctions, PhaseTotals.NumTaggedFunctions, Iterations, TotalSeconds * 1000.0 / Iterations, MinSeconds * 1000.0, MaxSeconds * 1000.0);
+			UE_LOG(LogCustomEditorHotkeys, Display, TEXT("  gather %.3f ms, dispatch tables %.3f ms, command registration %.3f ms"),
+				PhaseTotals.GatherSeconds * 1000.0 / Iterations, PhaseTotals.DispatchSeconds * 1000.0 / Iterations, PhaseTotals.RegisterSeconds * 1000.0 / Iterations);
+		}));
+
+static FAutoConsoleCommand BenchmarkGatherUtilitiesCommand(
+	TEXT("CustomEditorHotkeys.Benchmark.GatherUtilities"),
+	TEXT("Gathers the utility blueprints repeatedly, with and without the cached derived class names, and logs the average time. Usage: CustomEditorHotkeys.Benchmark.GatherUtilities [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10;
+			const FName UtilityClassNames[] = { UActorActionUtility::StaticClass()->GetFName(), UAssetActionUtility::StaticClass()->GetFName() };
+
+			auto Gather = [&UtilityClassNames](bool bInvalidateCache, int32& OutNumAssets)
+			{
+				if (bInvalidateCache)
+				{
+					FCustomEditorHotkeysBlutilityExtensions::InvalidateDerivedClassCache();
+				}
+
+				const double StartTime = FPlatformTime::Seconds();
+				TArray<FAssetData> Assets;
+				for (const FName& UtilityClassName : UtilityClassNames)
+				{
+					FCustomEditorHotkeysBlutilityExtensions::GetBlutilityClasses(Assets, UtilityClassName);
+				}
+				OutNumAssets = Assets.Num();
+				return FPlatformTime::Seconds() - StartTime;
+			};
+
+			int32 NumAssets = 0;
+			double ColdSeconds = 0.0;
+			double WarmSeconds = 0.0;
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				ColdSeconds += Gather(true, NumAssets);
+				WarmSeconds += Gather(false, NumAssets);
+			}
+
+			UE_LOG(LogCustomEditorHotkeys, Display, TEXT("Gathered %d utility blueprints over %d iterations: avg %.3f ms uncached, %.3f ms with cached derived classes"),
+				NumAssets, Iterations, ColdSeconds * 1000.0 / Iterations, WarmSeconds * 1000.0 / Iterations);
+		}));
@@ -1,6 +1,14 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CustomEditorHotkeysCommands.h"
+#include "CustomEditorHotkeys.h"
+#include "CustomEditorHotkeysDispatch.h"
+#include "CustomEditorHotkeysSelectionTracker.h"
+#include "CustomEditorHotkeysSettings.h"
+#include "CustomEditorHotkeysMacros.h"
+#include "CustomEditorHotkeysPythonScripts.h"
+#include "SCustomEditorHotkeysParameterPanel.h"
+#include "CustomEditorHotkeysRegistryTags.h"
 
 #include "AssetRegistryModule.h"
 #include "BlueprintEditorModule.h"
@@ -14,6 +22,8 @@
 #include "Editor/UnrealEdEngine.h"
 #include "Subsystems/EditorActorSubsystem.h"
 #include "UnrealEdGlobals.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Async/ParallelFor.h"
 #include <Blutility/Public/EditorUtilityLibrary.h>
 
 #define LOCTEXT_NAMESPACE "FCustomEditorHotkeysModule"
@@ -21,102 +31,401 @@
 void FCustomEditorHotkeysCommands::RegisterCommands()
 {
 	UI_COMMAND(PluginAction, "Refresh Custom Editor Hotkeys", "Refresh mapped hotkeys, adding new commands to the editor preferences and removing outdated ones.", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(ToggleMacroRecording, "Record Hotkey Macro", "Start recording custom commands into a macro, or stop and save the recorded macro as a new command.", EUserInterfaceActionType::ToggleButton, FInputChord());
 }
 
+const FName FCustomEditorHotkeysBlutilityExtensions::NAME_HotkeyIcon(TEXT("HotkeyIcon"));
+const FName FCustomEditorHotkeysBlutilityExtensions::NAME_HotkeyTargets(TEXT("HotkeyTargets"));
+const FName FCustomEditorHotkeysBlutilityExtensions::NAME_DefaultTargetParam(TEXT("Targets"));
+
 void FCustomEditorHotkeysCommands::RegisterCustomCommands()
 {
-	TArray<FAssetData> Assets;
-	FCustomEditorHotkeysBlutilityExtensions::GetBlutilityClasses(Assets, UActorActionUtility::StaticClass()->GetFName());
-	FCustomEditorHotkeysBlutilityExtensions::GetBlutilityClasses(Assets, UAssetActionUtility::StaticClass()->GetFName());
-		
+	const double GatherStartTime = FPlatformTime::Seconds();
+
+	TArray<FAssetData> ActorUtilityAssets;
+	TArray<FAssetData> AssetUtilityAssets;
+	FCustomEditorHotkeysBlutilityExtensions::GetBlutilityClasses(ActorUtilityAssets, UActorActionUtility::StaticClass()->GetFName());
+	FCustomEditorHotkeysBlutilityExtensions::GetBlutilityClasses(AssetUtilityAssets, UAssetActionUtility::StaticClass()->GetFName());
+
+	// Blueprints saved with the hotkey functions tag are registered from it without being loaded. Loaded blueprints may have
+	// unsaved changes the tag doesn't know about, so they are read directly like the ones saved before the tag existed.
+	struct FTaggedUtilityEntry
+	{
+		FCustomEditorHotkeysRegistryTags::FTaggedUtility Utility;
+		const UClass* SupportedClass;
+	};
+
 	TArray<FCustomEditorHotkeysBlutilityExtensions::FFunctionAndUtil> UtilityFunctions;
+	TArray<FTaggedUtilityEntry> TaggedActorUtilities;
+	TArray<FTaggedUtilityEntry> TaggedAssetUtilities;
 
-	for (FAssetData& Asset : Assets)
+	auto GatherUtilityFunctions = [&UtilityFunctions](TArray<FAssetData>& Assets, TArray<FTaggedUtilityEntry>& OutTaggedUtilities)
 	{
-		if (UEditorUtilityBlueprint* Blueprint = Cast<UEditorUtilityBlueprint>(Asset.GetAsset()))
+		for (FAssetData& Asset : Assets)
 		{
-			if (UClass* BPClass = Blueprint->GeneratedClass.Get())
+			if (!Asset.IsAssetLoaded())
 			{
-				if (UEditorUtilityObject* DefaultObject = Cast<UEditorUtilityObject>(BPClass->GetDefaultObject()))
-				{					
-					FCustomEditorHotkeysBlutilityExtensions::GetUtilityFunctions(DefaultObject, UtilityFunctions);
+				FCustomEditorHotkeysRegistryTags::FTaggedUtility TaggedUtility;
+				if (FCustomEditorHotkeysRegistryTags::ReadTag(Asset, TaggedUtility))
+				{
+					// Supported classes are nearly always native, only a blueprint class that isn't loaded yet needs loading.
+					// That has to happen here, before the class index is rebuilt, or the class would dispatch as its parent.
+					const UClass* SupportedClass = nullptr;
+					if (TaggedUtility.SupportedClass.IsValid())
+					{
+						SupportedClass = TaggedUtility.SupportedClass.ResolveClass();
+						if (!SupportedClass)
+						{
+							SupportedClass = TaggedUtility.SupportedClass.TryLoadClass<UObject>();
+						}
+						if (!SupportedClass)
+						{
+							UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("\"%s\" supports the missing class \"%s\", its commands were skipped."), *TaggedUtility.UtilityClass.ToString(), *TaggedUtility.SupportedClass.ToString());
+							continue;
+						}
+					}
+
+					OutTaggedUtilities.Add({ MoveTemp(TaggedUtility), SupportedClass });
+					continue;
+				}
+			}
+
+			if (UEditorUtilityBlueprint* Blueprint = Cast<UEditorUtilityBlueprint>(Asset.GetAsset()))
+			{
+				if (UClass* BPClass = Blueprint->GeneratedClass.Get())
+				{
+					if (UEditorUtilityObject* DefaultObject = Cast<UEditorUtilityObject>(BPClass->GetDefaultObject()))
+					{
+						FCustomEditorHotkeysBlutilityExtensions::GetUtilityFunctions(DefaultObject, UtilityFunctions);
+					}
 				}
 			}
 		}
-	}
+	};
 
-	for (auto& Command : CustomLevelEditorCommands)
+	GatherUtilityFunctions(ActorUtilityAssets, TaggedActorUtilities);
+	GatherUtilityFunctions(AssetUtilityAssets, TaggedAssetUtilities);
+
+	int32 NumTaggedFunctions = 0;
+	for (const TArray<FTaggedUtilityEntry>* TaggedUtilities : { &TaggedActorUtilities, &TaggedAssetUtilities })
 	{
-		FUICommandInfo::UnregisterCommandInfo(AsShared(), Command.Value.ToSharedRef());
+		for (const FTaggedUtilityEntry& TaggedUtility : *TaggedUtilities)
+		{
+			NumTaggedFunctions += TaggedUtility.Utility.Functions.Num();
+		}
 	}
-	CustomLevelEditorCommands.Empty();
 
-	for (auto& Command : CustomContentBrowserCommands)
+	const double DispatchStartTime = FPlatformTime::Seconds();
+
+	TSharedRef<FCustomEditorHotkeysClassIndex> ClassIndex = MakeShared<FCustomEditorHotkeysClassIndex>();
+	ClassIndex->Rebuild();
+
+	LevelEditorDispatchTable = MakeShared<FCustomEditorHotkeysDispatchTable>(ClassIndex);
+	ContentBrowserDispatchTable = MakeShared<FCustomEditorHotkeysDispatchTable>(ClassIndex);
+
+	struct FPendingCommand
 	{
-		FUICommandInfo::UnregisterCommandInfo(AsShared(), Command.Value.ToSharedRef());
-	}
-	CustomContentBrowserCommands.Empty();
+		FName Name;
+		FString Description;
+		FString IconPath;
+		FCommandInfoMap* CommandMap;
+	};
+
+	const UCustomEditorHotkeysSettings* Settings = GetDefault<UCustomEditorHotkeysSettings>();
+
+	TArray<FPendingCommand> PendingCommands;
+	PendingCommands.Reserve(UtilityFunctions.Num() + NumTaggedFunctions + Settings->Macros.Num());
+
+	auto AddPendingFunctionCommand = [&PendingCommands, Settings](FName FunctionName, FString Description, FString IconPath, FCommandInfoMap& CommandMap)
+	{
+		if (IconPath.IsEmpty())
+		{
+			if (const FFilePath* ConfiguredIcon = Settings->CommandIcons.Find(FunctionName))
+			{
+				IconPath = ConfiguredIcon->FilePath;
+			}
+		}
 
-	FCommandInfoMap DummyMap;
+		PendingCommands.Add({ FunctionName, MoveTemp(Description), MoveTemp(IconPath), &CommandMap });
+	};
+
+	TSet<FName> PendingLevelEditorCommands;
+	TSet<FName> PendingContentBrowserCommands;
+
+	for (const FCustomEditorHotkeysBlutilityExtensions::FFunctionAndUtil& UtilityFunction : UtilityFunctions)
+	{
+		FName FunctionName = UtilityFunction.Function->GetFName();
 
-	auto GetAppropriateCommandMapForUtility = [&](const UEditorUtilityObject* UtilityObject) -> FCommandInfoMap& {
-		
-		if (UtilityObject->IsA<UActorActionUtility>())
+		// Functions sharing a name become overloads of a single command, picked by the class of the selection
+		if (UActorActionUtility* ActorUtility = Cast<UActorActionUtility>(UtilityFunction.Util))
 		{
-			return CustomLevelEditorCommands;
+			if (LevelEditorDispatchTable->AddOverload(FunctionName, UtilityFunction, ActorUtility->GetSupportedClass()) && !PendingLevelEditorCommands.Contains(FunctionName))
+			{
+				PendingLevelEditorCommands.Add(FunctionName);
+				AddPendingFunctionCommand(FunctionName, UtilityFunction.Function->GetDesc(), UtilityFunction.Function->GetMetaData(FCustomEditorHotkeysBlutilityExtensions::NAME_HotkeyIcon), CustomLevelEditorCommands);
+			}
 		}
-		else if (UtilityObject->IsA<UAssetActionUtility>())
+		else if (UAssetActionUtility* AssetUtility = Cast<UAssetActionUtility>(UtilityFunction.Util))
 		{
-			return CustomContentBrowserCommands;
+			if (ContentBrowserDispatchTable->AddOverload(FunctionName, UtilityFunction, AssetUtility->GetSupportedClass()) && !PendingContentBrowserCommands.Contains(FunctionName))
+			{
+				PendingContentBrowserCommands.Add(FunctionName);
+				AddPendingFunctionCommand(FunctionName, UtilityFunction.Function->GetDesc(), UtilityFunction.Function->GetMetaData(FCustomEditorHotkeysBlutilityExtensions::NAME_HotkeyIcon), CustomContentBrowserCommands);
+			}
 		}
+	}
 
-		return DummyMap;
+	auto AddTaggedUtilities = [&AddPendingFunctionCommand](const TArray<FTaggedUtilityEntry>& TaggedUtilities, FCustomEditorHotkeysDispatchTable& DispatchTable, TSet<FName>& PendingNames, FCommandInfoMap& CommandMap)
+	{
+		for (const FTaggedUtilityEntry& TaggedUtility : TaggedUtilities)
+		{
+			for (const FCustomEditorHotkeysRegistryTags::FTaggedFunction& TaggedFunction : TaggedUtility.Utility.Functions)
+			{
+				if (DispatchTable.AddOverload(TaggedFunction.Name, TaggedUtility.Utility.UtilityClass, TaggedUtility.SupportedClass) && !PendingNames.Contains(TaggedFunction.Name))
+				{
+					PendingNames.Add(TaggedFunction.Name);
+					AddPendingFunctionCommand(TaggedFunction.Name, TaggedFunction.Description, TaggedFunction.IconPath, CommandMap);
+				}
+			}
+		}
 	};
 
-	for (const FCustomEditorHotkeysBlutilityExtensions::FFunctionAndUtil& UtilityFunction : UtilityFunctions)
+	AddTaggedUtilities(TaggedActorUtilities, *LevelEditorDispatchTable, PendingLevelEditorCommands, CustomLevelEditorCommands);
+	AddTaggedUtilities(TaggedAssetUtilities, *ContentBrowserDispatchTable, PendingContentBrowserCommands, CustomContentBrowserCommands);
+
+	// Python script functions are called directly, they have no overloads to dispatch between
+	if (FCustomEditorHotkeysPythonScripts::IsInitialized())
 	{
-		FName FunctionName = FName(UtilityFunction.Function->GetName());
-		FCommandInfoMap& CommandMap = GetAppropriateCommandMapForUtility(UtilityFunction.Util);
+		for (const FCustomEditorHotkeysPythonScripts::FEntryPoint& EntryPoint : FCustomEditorHotkeysPythonScripts::Get().GetEntryPoints())
+		{
+			TSet<FName>& PendingNames = EntryPoint.bContentBrowserCommand ? PendingContentBrowserCommands : PendingLevelEditorCommands;
+			if (PendingNames.Contains(EntryPoint.CommandName))
+			{
+				UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Python command \"%s\" has the same name as a utility function and was skipped."), *EntryPoint.CommandName.ToString());
+				continue;
+			}
+
+			const FFilePath* ConfiguredIcon = Settings->CommandIcons.Find(EntryPoint.CommandName);
+			PendingNames.Add(EntryPoint.CommandName);
+			PendingCommands.Add({ EntryPoint.CommandName, EntryPoint.Description, ConfiguredIcon ? ConfiguredIcon->FilePath : FString(), EntryPoint.bContentBrowserCommand ? &CustomContentBrowserCommands : &CustomLevelEditorCommands });
+		}
+	}
 
-		if (CommandMap.Contains(FunctionName))
+	// Recorded macros get a command of their own so they can be bound to a chord
+	TSet<FName> PendingMacroCommands;
+	for (const FCustomEditorHotkeysMacro& Macro : Settings->Macros)
+	{
+		const FName MacroCommandName = FCustomEditorHotkeysMacros::GetMacroCommandName(Macro.Name);
+		if (!Macro.Name.IsNone() && !PendingMacroCommands.Contains(MacroCommandName))
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Duplicate custom command name found. Ignoring: \"%s\""), *FunctionName.ToString());
-			continue;
+			PendingMacroCommands.Add(MacroCommandName);
+			PendingCommands.Add({ MacroCommandName, FString::Printf(TEXT("Replays the %d commands recorded in the \"%s\" hotkey macro."), Macro.Steps.Num(), *Macro.Name.ToString()), FString(), &CustomMacroCommands });
 		}
+	}
+
+	LevelEditorDispatchTable->Finalize();
+	ContentBrowserDispatchTable->Finalize();
+
+	const double RegisterStartTime = FPlatformTime::Seconds();
 
-		FName DotName("." + FunctionName.ToString());
-		ANSICHAR AnsiDotName[NAME_SIZE];
-		DotName.GetPlainANSIString(AnsiDotName);
+	{
+		// Unregistering and registering each notify binding context listeners, the engine offers no way to batch those.
+		// Everything else about the commands is worked out before the first one is touched.
+		for (auto& Command : CustomLevelEditorCommands)
+		{
+			FUICommandInfo::UnregisterCommandInfo(AsShared(), Command.Value.ToSharedRef());
+		}
+		CustomLevelEditorCommands.Empty(PendingLevelEditorCommands.Num());
+
+		for (auto& Command : CustomContentBrowserCommands)
+		{
+			FUICommandInfo::UnregisterCommandInfo(AsShared(), Command.Value.ToSharedRef());
+		}
+		CustomContentBrowserCommands.Empty(PendingContentBrowserCommands.Num());
+
+		for (auto& Command : CustomMacroCommands)
+		{
+			FUICommandInfo::UnregisterCommandInfo(AsShared(), Command.Value.ToSharedRef());
+		}
+		CustomMacroCommands.Empty(PendingMacroCommands.Num());
 
-		TSharedPtr<FUICommandInfo> NewCommand;
-		FUICommandInfo::MakeCommandInfo(AsShared(),
-			NewCommand,
-			FunctionName,
-			FText::AsCultureInvariant(FunctionName.ToString()),
-			FText::AsCultureInvariant(UtilityFunction.Function->GetDesc()),
-			FSlateIcon(GetStyleSetName(), ISlateStyle::Join(GetContextName(), AnsiDotName)),
-			EUserInterfaceActionType::Button,
-			FInputChord()
-		);
-		CommandMap.Add(FunctionName, NewCommand);
+		// Every icon key is "<Context>.<Command>", build them all in one buffer sized up front rather than going through
+		// temporary strings and names for each command.
+		TStringBuilder<256> ContextPrefix;
+		ContextPrefix << GetContextName() << TEXT('.');
+
+		int32 IconKeysLength = 0;
+		for (const FPendingCommand& PendingCommand : PendingCommands)
+		{
+			IconKeysLength += ContextPrefix.Len() + PendingCommand.Name.GetStringLength();
+		}
+
+		FString IconKeys;
+		IconKeys.Reserve(IconKeysLength);
+
+		TArray<FName> IconNames;
+		IconNames.Reserve(PendingCommands.Num());
+
+		for (const FPendingCommand& PendingCommand : PendingCommands)
+		{
+			const int32 KeyStart = IconKeys.Len();
+			IconKeys.Append(ContextPrefix.ToString(), ContextPrefix.Len());
+			PendingCommand.Name.AppendString(IconKeys);
+			IconNames.Add(FName(IconKeys.Len() - KeyStart, *IconKeys + KeyStart));
+		}
+
+		FCustomEditorHotkeysStyle::ClearCommandIcons();
+		const FSlateIcon DefaultIcon(FEditorStyle::GetStyleSetName(), "GraphEditor.Event_16x");
+
+		for (int32 Index = 0; Index < PendingCommands.Num(); ++Index)
+		{
+			const FPendingCommand& PendingCommand = PendingCommands[Index];
+
+			// Icons are only declared here, the style loads them the first time a menu or toolbar shows them
+			const FString& IconPath = PendingCommand.IconPath;
+			if (!IconPath.IsEmpty())
+			{
+				FCustomEditorHotkeysStyle::SetCommandIcon(IconNames[Index], FPaths::IsRelative(IconPath) ? FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), IconPath) : IconPath);
+			}
+
+			TSharedPtr<FUICommandInfo> NewCommand;
+			FUICommandInfo::MakeCommandInfo(AsShared(),
+				NewCommand,
+				PendingCommand.Name,
+				FText::AsCultureInvariant(PendingCommand.Name.ToString()),
+				FText::AsCultureInvariant(PendingCommand.Description),
+				IconPath.IsEmpty() ? DefaultIcon : FSlateIcon(GetStyleSetName(), IconNames[Index]),
+				EUserInterfaceActionType::Button,
+				FInputChord()
+			);
+			PendingCommand.CommandMap->Add(PendingCommand.Name, NewCommand);
+		}
 	}
 
 	CommandsChanged.Broadcast(*this);
+
+	const double EndTime = FPlatformTime::Seconds();
+	LastRefreshStats.NumUtilityFunctions = UtilityFunctions.Num() + NumTaggedFunctions;
+	LastRefreshStats.NumTaggedFunctions = NumTaggedFunctions;
+	LastRefreshStats.NumCommands = PendingCommands.Num();
+	LastRefreshStats.GatherSeconds = DispatchStartTime - GatherStartTime;
+	LastRefreshStats.DispatchSeconds = RegisterStartTime - DispatchStartTime;
+	LastRefreshStats.RegisterSeconds = EndTime - RegisterStartTime;
 }
 
 //////////////////////////////////////////////////////////////////////////
 
+/**
+ * Classes derived from each utility base class, as reported by the asset registry. Kept until blueprint assets are added,
+ * removed, renamed or updated, a blueprint is compiled (it may have been reparented) or native code is reloaded.
+ */
+struct FDerivedClassNameCache
+{
+	TMap<FName, TSet<FName>> DerivedClassNames;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+	FDelegateHandle BlueprintCompiledHandle;
+	FDelegateHandle ReloadCompleteHandle;
+
+	bool bListening = false;
+
+	void Listen(IAssetRegistry& AssetRegistry)
+	{
+		if (bListening)
+		{
+			return;
+		}
+
+		bListening = true;
+		AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FDerivedClassNameCache::OnAssetChanged);
+		AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FDerivedClassNameCache::OnAssetChanged);
+		AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddLambda([this](const FAssetData& AssetData, const FString&) { OnAssetChanged(AssetData); });
+		AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FDerivedClassNameCache::OnAssetChanged);
+		ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason) { DerivedClassNames.Reset(); });
+		if (GEditor)
+		{
+			BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddLambda([this]() { DerivedClassNames.Reset(); });
+		}
+	}
+
+	/** Only blueprints add classes to the hierarchy, every other asset the registry scans or saves leaves the names valid */
+	void OnAssetChanged(const FAssetData& AssetData)
+	{
+		if (AssetData.TagsAndValues.Contains(FBlueprintTags::GeneratedClassPath))
+		{
+			DerivedClassNames.Reset();
+		}
+	}
+
+	void Release()
+	{
+		DerivedClassNames.Reset();
+		if (!bListening)
+		{
+			return;
+		}
+
+		bListening = false;
+		if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+		{
+			AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+			AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+			AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+			AssetRegistry->OnAssetUpdated().Remove(AssetUpdatedHandle);
+		}
+		FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+		if (GEditor)
+		{
+			GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+		}
+	}
+};
+
+static FDerivedClassNameCache DerivedClassNameCache;
+
+/** @return The object name of an export text class path, e.g. "BP_Tool_C" for "/Script/Engine.BlueprintGeneratedClass'/Game/BP_Tool.BP_Tool_C'" */
+static FStringView GetExportTextObjectName(FStringView ExportTextPath)
+{
+	if (ExportTextPath.EndsWith(TEXT('\'')))
+	{
+		ExportTextPath.LeftChopInline(1);
+	}
+
+	int32 SeparatorIndex = INDEX_NONE;
+	for (int32 Index = ExportTextPath.Len() - 1; Index >= 0; --Index)
+	{
+		const TCHAR Char = ExportTextPath[Index];
+		if (Char == TEXT('.') || Char == TEXT(':') || Char == TEXT('\'') || Char == TEXT('/'))
+		{
+			SeparatorIndex = Index;
+			break;
+		}
+	}
+
+	return ExportTextPath.RightChop(SeparatorIndex + 1);
+}
+
 void FCustomEditorHotkeysBlutilityExtensions::GetBlutilityClasses(TArray<FAssetData>& OutAssets, const FName& InClassName)
 {
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
 	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
 
 	// Get class names
-	TArray<FName> BaseNames;
-	BaseNames.Add(InClassName);
-	TSet<FName> Excluded;
-	TSet<FName> DerivedNames;
-	AssetRegistry.GetDerivedClassNames(BaseNames, Excluded, DerivedNames);
+	DerivedClassNameCache.Listen(AssetRegistry);
+	const TSet<FName>* CachedDerivedNames = DerivedClassNameCache.DerivedClassNames.Find(InClassName);
+	if (!CachedDerivedNames)
+	{
+		TArray<FName> BaseNames;
+		BaseNames.Add(InClassName);
+		TSet<FName> Excluded;
+		TSet<FName> DerivedNames;
+		AssetRegistry.GetDerivedClassNames(BaseNames, Excluded, DerivedNames);
+		CachedDerivedNames = &DerivedClassNameCache.DerivedClassNames.Add(InClassName, MoveTemp(DerivedNames));
+	}
+	const TSet<FName>& DerivedNames = *CachedDerivedNames;
 
 	// Now get all UEditorUtilityBlueprint assets
 	FARFilter Filter;
@@ -127,23 +436,57 @@ void FCustomEditorHotkeysBlutilityExtensions::GetBlutilityClasses(TArray<FAssetD
 	TArray<FAssetData> AssetList;
 	AssetRegistry.GetAssets(Filter, AssetList);
 
-	// Check each asset to see if it matches our type
-	for (const FAssetData& Asset : AssetList)
-	{
-		FAssetDataTagMapSharedView::FFindTagResult Result = Asset.TagsAndValues.FindTag(FBlueprintTags::GeneratedClassPath);
-		if (Result.IsSet())
+	// Check each asset to see if it matches our type. The tags are read-only here, so the list is split in contiguous chunks
+	// classified in parallel, each chunk only keeping the indices of its matches so the output stays in registry order.
+	const int32 MinAssetsPerChunk = 512;
+	const int32 NumChunks = FMath::Clamp(AssetList.Num() / MinAssetsPerChunk, 1, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+	const int32 AssetsPerChunk = FMath::DivideAndRoundUp(AssetList.Num(), NumChunks);
+
+	TArray<TArray<int32>> ChunkMatches;
+	ChunkMatches.SetNum(NumChunks);
+
+	ParallelFor(NumChunks, [&AssetList, &DerivedNames, &ChunkMatches, AssetsPerChunk](int32 ChunkIndex)
 		{
-			const FString ClassObjectPath = FPackageName::ExportTextPathToObjectPath(Result.GetValue());
-			const FString ClassName = FPackageName::ObjectPathToObjectName(ClassObjectPath);
+			const int32 Begin = ChunkIndex * AssetsPerChunk;
+			const int32 End = FMath::Min(Begin + AssetsPerChunk, AssetList.Num());
 
-			if (DerivedNames.Contains(*ClassName))
+			for (int32 AssetIndex = Begin; AssetIndex < End; ++AssetIndex)
 			{
-				OutAssets.Add(Asset);
+				FAssetDataTagMapSharedView::FFindTagResult Result = AssetList[AssetIndex].TagsAndValues.FindTag(FBlueprintTags::GeneratedClassPath);
+				if (Result.IsSet())
+				{
+					const FString GeneratedClassPath = Result.GetValue();
+					const FStringView ClassName = GetExportTextObjectName(GeneratedClassPath);
+
+					// Only looks the name up, a class the registry doesn't know about can't be one of the derived names
+					const FName ClassFName(ClassName.Len(), ClassName.GetData(), FNAME_Find);
+					if (!ClassFName.IsNone() && DerivedNames.Contains(ClassFName))
+					{
+						ChunkMatches[ChunkIndex].Add(AssetIndex);
+					}
+				}
 			}
+		}, NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	for (const TArray<int32>& Matches : ChunkMatches)
+	{
+		for (int32 AssetIndex : Matches)
+		{
+			OutAssets.Add(MoveTemp(AssetList[AssetIndex]));
 		}
 	}
 }
 
+void FCustomEditorHotkeysBlutilityExtensions::InvalidateDerivedClassCache()
+{
+	DerivedClassNameCache.DerivedClassNames.Reset();
+}
+
+void FCustomEditorHotkeysBlutilityExtensions::ReleaseCaches()
+{
+	DerivedClassNameCache.Release();
+}
+
 void FCustomEditorHotkeysBlutilityExtensions::CreateBlutilityActionsMenu(FMenuBuilder& MenuBuilder, TArray<UEditorUtilityObject*> Utils)
 {
 	const static FName NAME_CallInEditor(TEXT("CallInEditor"));
@@ -221,8 +564,8 @@ void FCustomEditorHotkeysBlutilityExtensions::CreateBlutilityActionsMenu(FMenuBu
 									else
 									{
 										// We dont run this on the CDO, as bad things could occur!
-										UObject* TempObject = NewObject<UObject>(GetTransientPackage(), Cast<UObject>(FunctionAndUtil.Util)->GetClass());
-										TempObject->AddToRoot(); // Some Blutility actions might run GC so the TempObject needs to be rooted to avoid getting destroyed
+										// Some Blutility actions might run GC so the TempObject needs to be referenced to avoid getting destroyed
+										TStrongObjectPtr<UObject> TempObject(NewObject<UObject>(GetTransientPackage(), Cast<UObject>(FunctionAndUtil.Util)->GetClass()));
 
 										if (FunctionAndUtil.Function->NumParms > 0)
 										{
@@ -265,8 +608,6 @@ void FCustomEditorHotkeysBlutilityExtensions::CreateBlutilityActionsMenu(FMenuBu
 											FEditorScriptExecutionGuard ScriptGuard;
 											TempObject->ProcessEvent(FunctionAndUtil.Function, nullptr);
 										}
-
-										TempObject->RemoveFromRoot();
 									}
 								}));
 					}
@@ -421,33 +762,293 @@ void FCustomEditorHotkeysBlutilityExtensions::ExecuteUtilityFunctionByName(FName
 
 void FCustomEditorHotkeysBlutilityExtensions::ExecuteActorUtilityFunctionByName(FName FunctionName)
 {
-	if (!GUnrealEd)
-		return;
+	FCustomEditorHotkeysMacros::FScopedRecordedPress RecordedPress;
+	const int32 NumExecuted = ExecuteActorUtilityFunctionOnSelection(FunctionName);
+	FCustomEditorHotkeysMacros::RecordCommand(FunctionName, false, NumExecuted > 0);
+}
+
+void FCustomEditorHotkeysBlutilityExtensions::ExecuteAssetUtilityFunctionByName(FName FunctionName)
+{
+	FCustomEditorHotkeysMacros::FScopedRecordedPress RecordedPress;
+	const int32 NumExecuted = ExecuteAssetUtilityFunctionOnSelection(FunctionName);
+	FCustomEditorHotkeysMacros::RecordCommand(FunctionName, true, NumExecuted > 0);
+}
+
+int32 FCustomEditorHotkeysBlutilityExtensions::ExecuteActorUtilityFunctionOnSelection(FName FunctionName, const TMap<FName, FString>* ParamValues /*= nullptr*/)
+{
+	TArray<const UClass*> SelectedClasses;
 
-	if (UEditorActorSubsystem* EditorActorSubsystem = GUnrealEd->GetEditorSubsystem<UEditorActorSubsystem>())
+	if (FCustomEditorHotkeysSelectionTracker::IsInitialized())
 	{
-		const TArray<AActor*> SelectedActors = EditorActorSubsystem->GetSelectedLevelActors();
-		const TArray<UEditorUtilityObject*> SupportedUtils = GetUtilitiesSupportedBySelectedActors(SelectedActors);
+		FCustomEditorHotkeysSelectionTracker::Get().GetSelectedActorClasses(SelectedClasses);
+	}
+	else
+	{
+		if (!GUnrealEd)
+			return 0;
 
-		ExecuteUtilityFunctionByName(FunctionName, SupportedUtils);
+		if (UEditorActorSubsystem* EditorActorSubsystem = GUnrealEd->GetEditorSubsystem<UEditorActorSubsystem>())
+		{
+			for (AActor* Actor : EditorActorSubsystem->GetSelectedLevelActors())
+			{
+				if (Actor)
+				{
+					SelectedClasses.AddUnique(Actor->GetClass());
+				}
+			}
+		}
 	}
+
+	return ExecuteUtilityFunctionForClasses(FunctionName, FCustomEditorHotkeysCommands::GetLevelEditorDispatchTable(), SelectedClasses, ParamValues);
 }
 
-void FCustomEditorHotkeysBlutilityExtensions::ExecuteAssetUtilityFunctionByName(FName FunctionName)
+int32 FCustomEditorHotkeysBlutilityExtensions::ExecuteAssetUtilityFunctionOnSelection(FName FunctionName, const TMap<FName, FString>* ParamValues /*= nullptr*/)
+{
+	TArray<const UClass*> SelectedClasses;
+
+	if (FCustomEditorHotkeysSelectionTracker::IsInitialized())
+	{
+		FCustomEditorHotkeysSelectionTracker::Get().GetSelectedAssetClasses(SelectedClasses);
+	}
+	else
+	{
+		for (UObject* Asset : UEditorUtilityLibrary::GetSelectedAssets())
+		{
+			if (Asset)
+			{
+				// Blueprint assets are matched against the class they generate
+				const UBlueprint* Blueprint = Cast<UBlueprint>(Asset);
+				const UClass* AssetClass = Blueprint && Blueprint->GeneratedClass ? Blueprint->GeneratedClass.Get() : Asset->GetClass();
+				SelectedClasses.AddUnique(AssetClass);
+			}
+		}
+	}
+
+	return ExecuteUtilityFunctionForClasses(FunctionName, FCustomEditorHotkeysCommands::GetContentBrowserDispatchTable(), SelectedClasses, ParamValues);
+}
+
+int32 FCustomEditorHotkeysBlutilityExtensions::ExecuteActorUtilityFunctionOnActors(FName FunctionName, const TArray<AActor*>& Actors, const TMap<FName, FString>* ParamValues /*= nullptr*/)
+{
+	TArray<FExplicitTarget> Targets;
+	Targets.Reserve(Actors.Num());
+	for (AActor* Actor : Actors)
+	{
+		if (Actor)
+		{
+			Targets.Add({ Actor->GetClass(), Actor->GetClass(), Actor, nullptr });
+		}
+	}
+
+	return ExecuteUtilityFunctionOnTargets(FunctionName, FCustomEditorHotkeysCommands::GetLevelEditorDispatchTable(), Targets, ParamValues);
+}
+
+int32 FCustomEditorHotkeysBlutilityExtensions::ExecuteAssetUtilityFunctionOnAssets(FName FunctionName, const TArray<FAssetData>& Assets, const TMap<FName, FString>* ParamValues /*= nullptr*/)
 {
-	const TArray<UObject*> SelectedAssets = UEditorUtilityLibrary::GetSelectedAssets();
-	const TArray<UEditorUtilityObject*> SupportedUtils = GetUtilitiesSupportedBySelectedAssets(SelectedAssets);
-	
-	ExecuteUtilityFunctionByName(FunctionName, SupportedUtils);
+	TArray<FExplicitTarget> Targets;
+	Targets.Reserve(Assets.Num());
+	for (const FAssetData& Asset : Assets)
+	{
+		if (const UClass* DispatchClass = FCustomEditorHotkeysSelectionTracker::GetDispatchClass(Asset))
+		{
+			Targets.Add({ DispatchClass, Asset.GetClass(), nullptr, &Asset });
+		}
+	}
+
+	return ExecuteUtilityFunctionOnTargets(FunctionName, FCustomEditorHotkeysCommands::GetContentBrowserDispatchTable(), Targets, ParamValues);
 }
 
-void FCustomEditorHotkeysBlutilityExtensions::ExecuteUtilityFunction(const FFunctionAndUtil& FunctionAndUtil)
-{	
+int32 FCustomEditorHotkeysBlutilityExtensions::ExecuteUtilityFunctionOnTargets(FName FunctionName, const TSharedPtr<const FCustomEditorHotkeysDispatchTable>& DispatchTable, TArrayView<FExplicitTarget> Targets, const TMap<FName, FString>* ParamValues)
+{
+	if (!DispatchTable.IsValid())
+	{
+		return 0;
+	}
+
+	// Targets resolving to the same overload are handed to it together
+	TArray<TPair<FFunctionAndUtil, TArray<FExplicitTarget*>>, TInlineAllocator<4>> Groups;
+	for (FExplicitTarget& Target : Targets)
+	{
+		const FFunctionAndUtil* FunctionAndUtil = DispatchTable->Resolve(FunctionName, Target.DispatchClass);
+		if (!FunctionAndUtil)
+		{
+			continue;
+		}
+
+		TPair<FFunctionAndUtil, TArray<FExplicitTarget*>>* Group = Groups.FindByPredicate([FunctionAndUtil](const TPair<FFunctionAndUtil, TArray<FExplicitTarget*>>& Candidate) { return Candidate.Key == *FunctionAndUtil; });
+		if (!Group)
+		{
+			Group = &Groups.Emplace_GetRef(*FunctionAndUtil, TArray<FExplicitTarget*>());
+		}
+		Group->Value.Add(&Target);
+	}
+
+	int32 NumExecuted = 0;
+	for (const TPair<FFunctionAndUtil, TArray<FExplicitTarget*>>& Group : Groups)
+	{
+		TArray<const UClass*> ObjectClasses;
+		for (const FExplicitTarget* Target : Group.Value)
+		{
+			ObjectClasses.Add(Target->ObjectClass);
+		}
+
+		// Checked against the target classes first, assets are only loaded once they can actually be passed
+		const FProperty* TargetParam = FindTargetParam(Group.Key.Function, ObjectClasses);
+		if (!TargetParam)
+		{
+			UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("\"%s\" of \"%s\" has no target parameter and was skipped. Name an object or object array parameter \"%s\", or set the function's %s metadata, to run it on explicit targets."),
+				*FunctionName.ToString(), *GetNameSafe(Cast<UObject>(Group.Key.Util)), *NAME_DefaultTargetParam.ToString(), *NAME_HotkeyTargets.ToString());
+			continue;
+		}
+
+		if (!IsTargetParamFree(Group.Key.Function, TargetParam, ParamValues))
+		{
+			continue;
+		}
+
+		TArray<UObject*> Objects;
+		for (FExplicitTarget* Target : Group.Value)
+		{
+			if (!Target->Object && Target->AssetData)
+			{
+				Target->Object = Target->AssetData->GetAsset();
+			}
+			Objects.Add(Target->Object);
+		}
+
+		// An array parameter takes every target in one call, a single object parameter one target per call
+		const bool bArrayParam = TargetParam->IsA<FArrayProperty>();
+		bool bExecuted = false;
+		for (int32 Index = 0; Index < (bArrayParam ? 1 : Objects.Num()); ++Index)
+		{
+			TArrayView<UObject* const> CallObjects = bArrayParam ? MakeArrayView(Objects) : MakeArrayView(&Objects[Index], 1);
+			bExecuted |= ExecuteUtilityFunction(Group.Key, ParamValues, [TargetParam, CallObjects](void* ParamMemory)
+				{
+					SetTargetParam(TargetParam, ParamMemory, CallObjects);
+				});
+		}
+
+		if (bExecuted)
+		{
+			++NumExecuted;
+		}
+	}
+
+	return NumExecuted;
+}
+
+FProperty* FCustomEditorHotkeysBlutilityExtensions::FindTargetParam(const UFunction* Function, TArrayView<const UClass* const> TargetClasses)
+{
+	if (!Function)
+	{
+		return nullptr;
+	}
+
+	// Only the designated parameter takes targets, an unrelated object parameter of a fitting type is left alone
+	const FString& TargetParamName = Function->GetMetaData(NAME_HotkeyTargets);
+	const FName ParamName = TargetParamName.IsEmpty() ? NAME_DefaultTargetParam : FName(*TargetParamName);
+
+	FProperty* Param = FindFProperty<FProperty>(Function, ParamName);
+
+	// Blueprint array inputs are passed by reference, only skip actual outputs
+	if (!Param || !Param->HasAnyPropertyFlags(CPF_Parm) || Param->HasAnyPropertyFlags(CPF_ReturnParm) || (Param->HasAnyPropertyFlags(CPF_OutParm) && !Param->HasAnyPropertyFlags(CPF_ReferenceParm)))
+	{
+		return nullptr;
+	}
+
+	const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Param);
+	const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(ArrayProperty ? ArrayProperty->Inner : Param);
+	if (!ObjectProperty)
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Target parameter \"%s\" of \"%s\" is not an object or object array."), *ParamName.ToString(), *Function->GetName());
+		return nullptr;
+	}
+
+	const bool bAllTargetsFit = !TargetClasses.ContainsByPredicate([ObjectProperty](const UClass* TargetClass)
+		{
+			return !TargetClass || !TargetClass->IsChildOf(ObjectProperty->PropertyClass);
+		});
+
+	return bAllTargetsFit ? Param : nullptr;
+}
+
+bool FCustomEditorHotkeysBlutilityExtensions::IsTargetParamFree(const UFunction* Function, const FProperty* TargetParam, const TMap<FName, FString>* ParamValues)
+{
+	if (ParamValues && TargetParam && ParamValues->Contains(TargetParam->GetFName()))
+	{
+		UE_LOG(LogCustomEditorHotkeys, Error, TEXT("\"%s\" was given a value for its target parameter \"%s\" as well as explicit targets, it was not run."),
+			*GetNameSafe(Function), *TargetParam->GetName());
+		return false;
+	}
+
+	return true;
+}
+
+void FCustomEditorHotkeysBlutilityExtensions::SetTargetParam(const FProperty* TargetParam, void* ParamMemory, TArrayView<UObject* const> Targets)
+{
+	if (const FArrayProperty* ArrayParam = CastField<FArrayProperty>(TargetParam))
+	{
+		const FObjectPropertyBase* InnerProperty = CastFieldChecked<FObjectPropertyBase>(ArrayParam->Inner);
+		FScriptArrayHelper ArrayHelper(ArrayParam, ArrayParam->ContainerPtrToValuePtr<void>(ParamMemory));
+		ArrayHelper.Resize(Targets.Num());
+		for (int32 Index = 0; Index < Targets.Num(); ++Index)
+		{
+			InnerProperty->SetObjectPropertyValue(ArrayHelper.GetRawPtr(Index), Targets[Index]);
+		}
+	}
+	else if (const FObjectPropertyBase* ObjectParam = CastField<FObjectPropertyBase>(TargetParam))
+	{
+		ObjectParam->SetObjectPropertyValue(ObjectParam->ContainerPtrToValuePtr<void>(ParamMemory), Targets.Num() > 0 ? Targets[0] : nullptr);
+	}
+}
+
+int32 FCustomEditorHotkeysBlutilityExtensions::ExecuteUtilityFunctionForClasses(FName FunctionName, const TSharedPtr<const FCustomEditorHotkeysDispatchTable>& DispatchTable, TArrayView<const UClass* const> TargetClasses, const TMap<FName, FString>* ParamValues /*= nullptr*/)
+{
+	if (!DispatchTable.IsValid())
+	{
+		return 0;
+	}
+
+	// Mixed selections run each matching overload once, the utilities themselves operate on the whole selection
+	TArray<FFunctionAndUtil> Functions;
+	DispatchTable->ResolveAll(FunctionName, TargetClasses, Functions);
+
+	// The panel gets the whole set, handing it one overload at a time would have each retarget it away from the previous one
+	if (!ParamValues && SCustomEditorHotkeysParameterPanel::ShouldHandleCommand(Functions))
+	{
+		return SCustomEditorHotkeysParameterPanel::HandleCommand(Functions);
+	}
+
+	int32 NumExecuted = 0;
+	for (const FFunctionAndUtil& FunctionAndUtil : Functions)
+	{
+		if (ExecuteUtilityFunction(FunctionAndUtil, ParamValues))
+		{
+			++NumExecuted;
+		}
+	}
+
+	return NumExecuted;
+}
+
+bool FCustomEditorHotkeysBlutilityExtensions::ExecuteUtilityFunction(const FFunctionAndUtil& FunctionAndUtil, const TMap<FName, FString>* ParamValues /*= nullptr*/, TFunction<void(void* ParamMemory)> PopulateParams /*= nullptr*/)
+{
+	if (!FunctionAndUtil.Function || !FunctionAndUtil.Util)
+	{
+		return false;
+	}
+
+	if (!ParamValues && !PopulateParams && SCustomEditorHotkeysParameterPanel::ShouldHandleCommand(MakeArrayView(&FunctionAndUtil, 1)))
+	{
+		// The panel runs the function itself, once its parameters are confirmed
+		return SCustomEditorHotkeysParameterPanel::HandleCommand(MakeArrayView(&FunctionAndUtil, 1)) > 0;
+	}
+
 	// We dont run this on the CDO, as bad things could occur!
-	UObject* TempObject = NewObject<
-		UObject>(GetTransientPackage(), Cast<UObject>(FunctionAndUtil.Util)->GetClass());
-	TempObject->AddToRoot();
-	// Some Blutility actions might run GC so the TempObject needs to be rooted to avoid getting destroyed
+	// Some Blutility actions might run GC so the TempObject needs to be referenced to avoid getting destroyed. The strong
+	// pointer releases it on every path out of here, including a utility that throws a script exception.
+	TStrongObjectPtr<UObject> TempObject(NewObject<UObject>(GetTransientPackage(), Cast<UObject>(FunctionAndUtil.Util)->GetClass()));
+
+	bool bExecuted = true;
 
 	if (FunctionAndUtil.Function->NumParms > 0)
 	{
@@ -463,26 +1064,58 @@ void FCustomEditorHotkeysBlutilityExtensions::ExecuteUtilityFunction(const FFunc
 			}
 		}
 
-		// pop up a dialog to input params to the function
-		TSharedRef<SWindow> Window = SNew(SWindow)
-			.Title(FunctionAndUtil.Function->GetDisplayNameText())
-			.ClientSize(FVector2D(400, 200))
-			.SupportsMinimize(false)
-			.SupportsMaximize(false);
-
-		TSharedPtr<SFunctionParamDialog> Dialog;
-		Window->SetContent(
-			SAssignNew(Dialog, SFunctionParamDialog, Window, FuncParams)
-			.OkButtonText(LOCTEXT("OKButton", "OK"))
-			.OkButtonTooltipText(FunctionAndUtil.Function->GetToolTipText()));
+		if (ParamValues || PopulateParams)
+		{
+			// Parameters supplied by the caller replace the dialog, anything missing keeps its default
+			static const TMap<FName, FString> NoParamValues;
+			for (const TPair<FName, FString>& ParamValue : ParamValues ? *ParamValues : NoParamValues)
+			{
+				if (FProperty* Property = FindFProperty<FProperty>(FunctionAndUtil.Function, ParamValue.Key))
+				{
+					Property->ImportText(*ParamValue.Value, Property->ContainerPtrToValuePtr<uint8>(FuncParams->GetStructMemory()),
+						PPF_None, nullptr);
+				}
+				else
+				{
+					UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Function \"%s\" has no parameter named \"%s\"."), *FunctionAndUtil.Function->GetName(), *ParamValue.Key.ToString());
+				}
+			}
 
-		GEditor->EditorAddModalWindow(Window);
+			if (PopulateParams)
+			{
+				PopulateParams(FuncParams->GetStructMemory());
+			}
 
-		if (Dialog->bOKPressed)
-		{
 			FScopedTransaction Transaction(NSLOCTEXT("UnrealEd", "BlutilityAction", "Blutility Action"));
 			FEditorScriptExecutionGuard ScriptGuard;
 			TempObject->ProcessEvent(FunctionAndUtil.Function, FuncParams->GetStructMemory());
+			FCustomEditorHotkeysMacros::RecordParams(FunctionAndUtil.Function, FuncParams->GetStructMemory());
+		}
+		else
+		{
+			// pop up a dialog to input params to the function
+			TSharedRef<SWindow> Window = SNew(SWindow)
+				.Title(FunctionAndUtil.Function->GetDisplayNameText())
+				.ClientSize(FVector2D(400, 200))
+				.SupportsMinimize(false)
+				.SupportsMaximize(false);
+
+			TSharedPtr<SFunctionParamDialog> Dialog;
+			Window->SetContent(
+				SAssignNew(Dialog, SFunctionParamDialog, Window, FuncParams)
+				.OkButtonText(LOCTEXT("OKButton", "OK"))
+				.OkButtonTooltipText(FunctionAndUtil.Function->GetToolTipText()));
+
+			GEditor->EditorAddModalWindow(Window);
+
+			bExecuted = Dialog->bOKPressed;
+			if (Dialog->bOKPressed)
+			{
+				FScopedTransaction Transaction(NSLOCTEXT("UnrealEd", "BlutilityAction", "Blutility Action"));
+				FEditorScriptExecutionGuard ScriptGuard;
+				TempObject->ProcessEvent(FunctionAndUtil.Function, FuncParams->GetStructMemory());
+				FCustomEditorHotkeysMacros::RecordParams(FunctionAndUtil.Function, FuncParams->GetStructMemory());
+			}
 		}
 	}
 	else
@@ -492,7 +1125,7 @@ void FCustomEditorHotkeysBlutilityExtensions::ExecuteUtilityFunction(const FFunc
 		TempObject->ProcessEvent(FunctionAndUtil.Function, nullptr);
 	}
 
-	TempObject->RemoveFromRoot();
+	return bExecuted;
 }
 
 #undef LOCTEXT_NAMESPACE
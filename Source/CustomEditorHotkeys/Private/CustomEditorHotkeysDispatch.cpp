@@ -0,0 +1,316 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CustomEditorHotkeysDispatch.h"
+#include "CustomEditorHotkeys.h"
+#include "Algo/BinarySearch.h"
+#include "UObject/UObjectIterator.h"
+#include "EditorUtilityObject.h"
+
+void FCustomEditorHotkeysClassIndex::Rebuild()
+{
+	Ranges.Reset();
+
+	TMap<const UClass*, TArray<const UClass*>> Children;
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		const UClass* Class = *It;
+		if (Class->HasAnyClassFlags(CLASS_NewerVersionExists))
+		{
+			continue;
+		}
+
+		if (const UClass* SuperClass = Class->GetSuperClass())
+		{
+			Children.FindOrAdd(SuperClass).Add(Class);
+		}
+	}
+
+	// Depth-first walk, each class is visited once to open its range and once more to close it after its children
+	TArray<TPair<const UClass*, bool>> Stack;
+	Stack.Emplace(UObject::StaticClass(), false);
+
+	int32 NextIndex = 0;
+	while (Stack.Num() > 0)
+	{
+		const TPair<const UClass*, bool> Entry = Stack.Pop(false);
+		if (Entry.Value)
+		{
+			Ranges.FindChecked(Entry.Key).End = NextIndex;
+			continue;
+		}
+
+		Ranges.Add(Entry.Key).Begin = NextIndex++;
+		Stack.Emplace(Entry.Key, true);
+
+		if (const TArray<const UClass*>* ClassChildren = Children.Find(Entry.Key))
+		{
+			for (const UClass* Child : *ClassChildren)
+			{
+				Stack.Emplace(Child, false);
+			}
+		}
+	}
+
+	NumClasses = NextIndex;
+}
+
+FCustomEditorHotkeysClassIndex::FRange FCustomEditorHotkeysClassIndex::GetRange(const UClass* Class) const
+{
+	for (; Class; Class = Class->GetSuperClass())
+	{
+		if (const FRange* Range = Ranges.Find(Class))
+		{
+			return *Range;
+		}
+	}
+
+	return FRange();
+}
+
+FCustomEditorHotkeysClassIndex::FRange FCustomEditorHotkeysClassIndex::FindExactRange(const UClass* Class) const
+{
+	const FRange* Range = Ranges.Find(Class);
+	return Range ? *Range : FRange();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+FCustomEditorHotkeysDispatchTable::FOverload::FOverload(const FFunctionAndUtil& InFunctionAndUtil, const UClass* InSupportedClass)
+	: FunctionAndUtil(InFunctionAndUtil)
+	, WeakFunction(InFunctionAndUtil.Function)
+	, WeakUtil(Cast<UObject>(InFunctionAndUtil.Util))
+	, FunctionName(InFunctionAndUtil.Function ? InFunctionAndUtil.Function->GetFName() : NAME_None)
+	, bLoaded(true)
+	, SupportedClass(InSupportedClass)
+{
+}
+
+FCustomEditorHotkeysDispatchTable::FOverload::FOverload(FName InFunctionName, const FSoftClassPath& InUtilityClass, const UClass* InSupportedClass)
+	: FunctionAndUtil(nullptr, nullptr)
+	, FunctionName(InFunctionName)
+	, UtilityClass(InUtilityClass)
+	, bLoaded(false)
+	, SupportedClass(InSupportedClass)
+{
+}
+
+void FCustomEditorHotkeysDispatchTable::FOverload::Load() const
+{
+	if (bLoaded)
+	{
+		return;
+	}
+	bLoaded = true;
+
+	UClass* Class = UtilityClass.TryLoadClass<UObject>();
+	UEditorUtilityObject* DefaultObject = Class ? Cast<UEditorUtilityObject>(Class->GetDefaultObject()) : nullptr;
+	UFunction* Function = Class ? Class->FindFunctionByName(FunctionName) : nullptr;
+	if (!DefaultObject || !Function)
+	{
+		// Left unloaded pointers make the overload stale, a refresh picks up whatever the blueprint contains now
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("\"%s\" no longer has the function \"%s\" its asset registry tags list."), *UtilityClass.ToString(), *FunctionName.ToString());
+		return;
+	}
+
+	FunctionAndUtil = FFunctionAndUtil(Function, DefaultObject);
+	WeakFunction = Function;
+	WeakUtil = Cast<UObject>(DefaultObject);
+}
+
+bool FCustomEditorHotkeysDispatchTable::FOverload::IsStale() const
+{
+	if (!bLoaded)
+	{
+		return false;
+	}
+
+	const UObject* Util = WeakUtil.Get();
+	return !WeakFunction.IsValid() || !Util || Util->GetClass()->HasAnyClassFlags(CLASS_NewerVersionExists);
+}
+
+FCustomEditorHotkeysDispatchTable::FCustomEditorHotkeysDispatchTable(TSharedRef<const FCustomEditorHotkeysClassIndex> InClassIndex)
+	: ClassIndex(InClassIndex)
+{
+}
+
+bool FCustomEditorHotkeysDispatchTable::AddOverload(FName CommandName, const FFunctionAndUtil& FunctionAndUtil, const UClass* SupportedClass)
+{
+	FCommandEntry& Entry = Commands.FindOrAdd(CommandName);
+
+	if (Entry.Overloads.ContainsByPredicate([SupportedClass](const FOverload& Overload) { return Overload.SupportedClass == SupportedClass; }))
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Custom command \"%s\" already has an overload for class \"%s\". Ignoring the one from \"%s\"."),
+			*CommandName.ToString(), SupportedClass ? *SupportedClass->GetName() : TEXT("None"), *GetNameSafe(Cast<UObject>(FunctionAndUtil.Util)));
+		return false;
+	}
+
+	Entry.Overloads.Emplace(FunctionAndUtil, SupportedClass);
+	return true;
+}
+
+bool FCustomEditorHotkeysDispatchTable::AddOverload(FName CommandName, const FSoftClassPath& UtilityClass, const UClass* SupportedClass)
+{
+	FCommandEntry& Entry = Commands.FindOrAdd(CommandName);
+
+	if (Entry.Overloads.ContainsByPredicate([SupportedClass](const FOverload& Overload) { return Overload.SupportedClass == SupportedClass; }))
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Custom command \"%s\" already has an overload for class \"%s\". Ignoring the one from \"%s\"."),
+			*CommandName.ToString(), SupportedClass ? *SupportedClass->GetName() : TEXT("None"), *UtilityClass.ToString());
+		return false;
+	}
+
+	Entry.Overloads.Emplace(CommandName, UtilityClass, SupportedClass);
+	return true;
+}
+
+void FCustomEditorHotkeysDispatchTable::Finalize()
+{
+	const FCustomEditorHotkeysClassIndex::FRange AnyClassRange = ClassIndex->GetRange(UObject::StaticClass());
+
+	for (TPair<FName, FCommandEntry>& Pair : Commands)
+	{
+		FCommandEntry& Entry = Pair.Value;
+		Entry.Segments.Reset();
+		Entry.ResolvedClasses.Reset();
+
+		TArray<int32, TInlineAllocator<8>> Order;
+		for (int32 OverloadIndex = 0; OverloadIndex < Entry.Overloads.Num(); ++OverloadIndex)
+		{
+			FOverload& Overload = Entry.Overloads[OverloadIndex];
+
+			// A supported class missing from the index must not borrow its parent's range, the overload would then run on
+			// every sibling class as well
+			Overload.Range = Overload.SupportedClass ? ClassIndex->FindExactRange(Overload.SupportedClass) : AnyClassRange;
+
+			if (Overload.Range.IsValid())
+			{
+				Order.Add(OverloadIndex);
+			}
+			else
+			{
+				UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Custom command \"%s\" supports class \"%s\", which was loaded after the class index was built. Refresh the hotkeys to enable it."),
+					*Pair.Key.ToString(), *GetNameSafe(Overload.SupportedClass));
+			}
+		}
+
+		// Class ranges are either nested or disjoint, so visiting them outermost first lets a stack of open ranges
+		// paint every class index with the innermost overload that covers it.
+		Order.Sort([&Entry](int32 A, int32 B)
+			{
+				const FCustomEditorHotkeysClassIndex::FRange& RangeA = Entry.Overloads[A].Range;
+				const FCustomEditorHotkeysClassIndex::FRange& RangeB = Entry.Overloads[B].Range;
+				return RangeA.Begin != RangeB.Begin ? RangeA.Begin < RangeB.Begin : RangeA.End > RangeB.End;
+			});
+
+		TArray<int32, TInlineAllocator<8>> OpenOverloads;
+		int32 Cursor = 0;
+
+		auto AddSegment = [&Entry](int32 Begin, int32 End, int32 OverloadIndex)
+		{
+			if (Begin < End)
+			{
+				Entry.Segments.Add({ Begin, End, OverloadIndex });
+			}
+		};
+
+		auto AdvanceTo = [&](int32 Position)
+		{
+			while (OpenOverloads.Num() > 0 && Entry.Overloads[OpenOverloads.Last()].Range.End <= Position)
+			{
+				const int32 End = Entry.Overloads[OpenOverloads.Last()].Range.End;
+				AddSegment(Cursor, End, OpenOverloads.Pop(false));
+				Cursor = End;
+			}
+
+			if (OpenOverloads.Num() > 0)
+			{
+				AddSegment(Cursor, Position, OpenOverloads.Last());
+			}
+			Cursor = Position;
+		};
+
+		for (int32 OverloadIndex : Order)
+		{
+			AdvanceTo(Entry.Overloads[OverloadIndex].Range.Begin);
+			OpenOverloads.Add(OverloadIndex);
+		}
+		AdvanceTo(MAX_int32);
+	}
+}
+
+const FCustomEditorHotkeysDispatchTable::FFunctionAndUtil* FCustomEditorHotkeysDispatchTable::Resolve(FName CommandName, const UClass* TargetClass) const
+{
+	const FCommandEntry* Entry = Commands.Find(CommandName);
+	if (!Entry || !TargetClass)
+	{
+		return nullptr;
+	}
+
+	int32 Resolved = INDEX_NONE;
+	if (const int32* CachedOverload = Entry->ResolvedClasses.Find(TargetClass))
+	{
+		Resolved = *CachedOverload;
+	}
+	else
+	{
+		const FCustomEditorHotkeysClassIndex::FRange TargetRange = ClassIndex->GetRange(TargetClass);
+		if (TargetRange.IsValid())
+		{
+			const int32 SegmentIndex = Algo::UpperBoundBy(Entry->Segments, TargetRange.Begin, &FSegment::Begin) - 1;
+			if (Entry->Segments.IsValidIndex(SegmentIndex) && TargetRange.Begin < Entry->Segments[SegmentIndex].End)
+			{
+				Resolved = Entry->Segments[SegmentIndex].Overload;
+			}
+		}
+
+		Entry->ResolvedClasses.Add(TargetClass, Resolved);
+	}
+
+	if (Resolved == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	const FOverload& Overload = Entry->Overloads[Resolved];
+	Overload.Load();
+	if (Overload.IsStale())
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Custom command \"%s\" points at a utility that was recompiled or deleted, refresh the hotkeys to pick up the new version."), *CommandName.ToString());
+		return nullptr;
+	}
+
+	return &Overload.FunctionAndUtil;
+}
+
+void FCustomEditorHotkeysDispatchTable::ResolveAll(FName CommandName, TArrayView<const UClass* const> TargetClasses, TArray<FFunctionAndUtil>& OutFunctions) const
+{
+	for (const UClass* TargetClass : TargetClasses)
+	{
+		if (const FFunctionAndUtil* FunctionAndUtil = Resolve(CommandName, TargetClass))
+		{
+			OutFunctions.AddUnique(*FunctionAndUtil);
+		}
+	}
+}
+
+bool FCustomEditorHotkeysDispatchTable::HasStaleOverloads() const
+{
+	for (const TPair<FName, FCommandEntry>& Pair : Commands)
+	{
+		for (const FOverload& Overload : Pair.Value.Overloads)
+		{
+			if (Overload.IsStale())
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+const TArray<FCustomEditorHotkeysDispatchTable::FOverload>* FCustomEditorHotkeysDispatchTable::FindOverloads(FName CommandName) const
+{
+	const FCommandEntry* Entry = Commands.Find(CommandName);
+	return Entry ? &Entry->Overloads : nullptr;
+}
@@ -0,0 +1,255 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CustomEditorHotkeysMacros.h"
+#include "CustomEditorHotkeys.h"
+#include "CustomEditorHotkeysCommands.h"
+#include "CustomEditorHotkeysDispatch.h"
+#include "CustomEditorHotkeysPythonScripts.h"
+#include "CustomEditorHotkeysSelectionTracker.h"
+#include "CustomEditorHotkeysSettings.h"
+
+#include "HAL/IConsoleManager.h"
+#include "ScopedTransaction.h"
+
+#define LOCTEXT_NAMESPACE "FCustomEditorHotkeysModule"
+
+static bool bRecordingMacro = false;
+static bool bReplayingMacro = false;
+static int32 RecordedPressDepth = 0;
+static TArray<FCustomEditorHotkeysMacroStep> RecordedSteps;
+static TMap<FName, FString> RecordedParams;
+
+static FAutoConsoleCommand MacroStartCommand(
+	TEXT("CustomEditorHotkeys.Macro.Start"),
+	TEXT("Starts recording custom commands into a hotkey macro."),
+	FConsoleCommandDelegate::CreateStatic(&FCustomEditorHotkeysMacros::StartRecording));
+
+static FAutoConsoleCommand MacroStopCommand(
+	TEXT("CustomEditorHotkeys.Macro.Stop"),
+	TEXT("Stops recording and saves the hotkey macro, refresh the hotkeys to bind it. Usage: CustomEditorHotkeys.Macro.Stop [Name]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FCustomEditorHotkeysMacros::StopRecording(Args.Num() > 0 ? FName(*Args[0]) : NAME_None);
+		}));
+
+static FAutoConsoleCommand MacroReplayCommand(
+	TEXT("CustomEditorHotkeys.Macro.Replay"),
+	TEXT("Replays a saved hotkey macro. Usage: CustomEditorHotkeys.Macro.Replay <Name>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (Args.Num() > 0)
+			{
+				FCustomEditorHotkeysMacros::ReplayMacro(FName(*Args[0]));
+			}
+		}));
+
+FCustomEditorHotkeysMacros::FScopedRecordedPress::FScopedRecordedPress()
+{
+	++RecordedPressDepth;
+}
+
+FCustomEditorHotkeysMacros::FScopedRecordedPress::~FScopedRecordedPress()
+{
+	// Whatever the press didn't turn into a step is dropped with it
+	if (--RecordedPressDepth == 0)
+	{
+		RecordedParams.Reset();
+	}
+}
+
+void FCustomEditorHotkeysMacros::StartRecording()
+{
+	RecordedSteps.Reset();
+	RecordedParams.Reset();
+	bRecordingMacro = true;
+	UE_LOG(LogCustomEditorHotkeys, Log, TEXT("Recording hotkey macro."));
+}
+
+FName FCustomEditorHotkeysMacros::StopRecording(FName MacroName /*= NAME_None*/)
+{
+	if (!bRecordingMacro)
+	{
+		return NAME_None;
+	}
+
+	bRecordingMacro = false;
+	RecordedParams.Reset();
+
+	if (RecordedSteps.Num() == 0)
+	{
+		UE_LOG(LogCustomEditorHotkeys, Log, TEXT("Hotkey macro recording stopped, nothing was recorded."));
+		return NAME_None;
+	}
+
+	UCustomEditorHotkeysSettings* Settings = GetMutableDefault<UCustomEditorHotkeysSettings>();
+
+	auto HasMacro = [Settings](FName Name)
+	{
+		return Settings->Macros.ContainsByPredicate([Name](const FCustomEditorHotkeysMacro& Macro) { return Macro.Name == Name; });
+	};
+
+	if (MacroName.IsNone())
+	{
+		int32 MacroIndex = Settings->Macros.Num() + 1;
+		do
+		{
+			MacroName = FName(*FString::Printf(TEXT("Macro%d"), MacroIndex++));
+		} while (HasMacro(MacroName));
+	}
+
+	// Recording again under an existing name replaces that macro
+	Settings->Macros.RemoveAll([MacroName](const FCustomEditorHotkeysMacro& Macro) { return Macro.Name == MacroName; });
+
+	FCustomEditorHotkeysMacro& Macro = Settings->Macros.AddDefaulted_GetRef();
+	Macro.Name = MacroName;
+	Macro.Steps = MoveTemp(RecordedSteps);
+	Settings->SaveConfig();
+
+	UE_LOG(LogCustomEditorHotkeys, Log, TEXT("Saved hotkey macro \"%s\" with %d steps."), *MacroName.ToString(), Macro.Steps.Num());
+	return MacroName;
+}
+
+bool FCustomEditorHotkeysMacros::IsRecording()
+{
+	return bRecordingMacro;
+}
+
+void FCustomEditorHotkeysMacros::RecordParams(const UFunction* Function, const void* Params)
+{
+	if (!bRecordingMacro || bReplayingMacro || RecordedPressDepth == 0 || !Function || !Params)
+	{
+		return;
+	}
+
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		if (It->HasAnyPropertyFlags(CPF_ReturnParm | CPF_OutParm))
+		{
+			continue;
+		}
+
+		FString Value;
+		It->ExportTextItem(Value, It->ContainerPtrToValuePtr<void>(Params), nullptr, nullptr, PPF_None);
+		RecordedParams.Add(It->GetFName(), MoveTemp(Value));
+	}
+}
+
+void FCustomEditorHotkeysMacros::RecordCommand(FName CommandName, bool bContentBrowserCommand, bool bExecuted)
+{
+	if (!bRecordingMacro || bReplayingMacro || RecordedPressDepth != 1)
+	{
+		return;
+	}
+
+	// Cancelled dialogs and commands that had nothing to run on aren't worth replaying
+	if (bExecuted)
+	{
+		FCustomEditorHotkeysMacroStep& Step = RecordedSteps.AddDefaulted_GetRef();
+		Step.CommandName = CommandName;
+		Step.bContentBrowserCommand = bContentBrowserCommand;
+		Step.ParamValues = MoveTemp(RecordedParams);
+	}
+
+	RecordedParams.Reset();
+}
+
+void FCustomEditorHotkeysMacros::ReplayMacro(FName MacroName)
+{
+	const UCustomEditorHotkeysSettings* Settings = GetDefault<UCustomEditorHotkeysSettings>();
+	if (const FCustomEditorHotkeysMacro* Macro = Settings->Macros.FindByPredicate([MacroName](const FCustomEditorHotkeysMacro& Candidate) { return Candidate.Name == MacroName; }))
+	{
+		ReplayMacro(*Macro);
+	}
+	else
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("No hotkey macro named \"%s\"."), *MacroName.ToString());
+	}
+}
+
+int32 FCustomEditorHotkeysMacros::ReplayMacro(const FCustomEditorHotkeysMacro& Macro)
+{
+	if (Macro.Steps.Num() == 0)
+	{
+		return 0;
+	}
+
+	TSharedPtr<const FCustomEditorHotkeysDispatchTable> LevelEditorDispatchTable = FCustomEditorHotkeysCommands::GetLevelEditorDispatchTable();
+	TSharedPtr<const FCustomEditorHotkeysDispatchTable> ContentBrowserDispatchTable = FCustomEditorHotkeysCommands::GetContentBrowserDispatchTable();
+
+	TArray<const UClass*> SelectedActorClasses;
+	TArray<const UClass*> SelectedAssetClasses;
+	if (FCustomEditorHotkeysSelectionTracker::IsInitialized())
+	{
+		FCustomEditorHotkeysSelectionTracker::Get().GetSelectedActorClasses(SelectedActorClasses);
+		FCustomEditorHotkeysSelectionTracker::Get().GetSelectedAssetClasses(SelectedAssetClasses);
+	}
+
+	struct FResolvedStep
+	{
+		const FCustomEditorHotkeysMacroStep* Step;
+		int32 FirstFunction;
+		int32 NumFunctions;
+		bool bPythonScript;
+	};
+
+	TArray<FCustomEditorHotkeysBlutilityExtensions::FFunctionAndUtil> Functions;
+	TArray<FCustomEditorHotkeysBlutilityExtensions::FFunctionAndUtil> StepFunctions;
+	TArray<FResolvedStep> ResolvedSteps;
+	ResolvedSteps.Reserve(Macro.Steps.Num());
+
+	for (const FCustomEditorHotkeysMacroStep& Step : Macro.Steps)
+	{
+		// Script commands don't dispatch on the selection, they read it themselves when they run
+		if (FCustomEditorHotkeysPythonScripts::IsInitialized() && FCustomEditorHotkeysPythonScripts::Get().FindEntryPoint(Step.CommandName))
+		{
+			ResolvedSteps.Add({ &Step, Functions.Num(), 0, true });
+			continue;
+		}
+
+		const TSharedPtr<const FCustomEditorHotkeysDispatchTable>& DispatchTable = Step.bContentBrowserCommand ? ContentBrowserDispatchTable : LevelEditorDispatchTable;
+		const int32 FirstFunction = Functions.Num();
+		if (DispatchTable.IsValid())
+		{
+			// Resolved per step, the same function recorded twice runs twice
+			StepFunctions.Reset();
+			DispatchTable->ResolveAll(Step.CommandName, Step.bContentBrowserCommand ? SelectedAssetClasses : SelectedActorClasses, StepFunctions);
+			Functions.Append(StepFunctions);
+		}
+
+		if (Functions.Num() == FirstFunction)
+		{
+			UE_LOG(LogCustomEditorHotkeys, Verbose, TEXT("Macro \"%s\": \"%s\" has nothing to run on the current selection."), *Macro.Name.ToString(), *Step.CommandName.ToString());
+		}
+
+		ResolvedSteps.Add({ &Step, FirstFunction, Functions.Num() - FirstFunction, false });
+	}
+
+	TGuardValue<bool> ReplayGuard(bReplayingMacro, true);
+	FScopedTransaction Transaction(FText::Format(LOCTEXT("ReplayMacroTransaction", "Replay Hotkey Macro {0}"), FText::FromName(Macro.Name)));
+
+	int32 NumExecuted = 0;
+	for (const FResolvedStep& ResolvedStep : ResolvedSteps)
+	{
+		if (ResolvedStep.bPythonScript && FCustomEditorHotkeysPythonScripts::RunScriptCommand(ResolvedStep.Step->CommandName))
+		{
+			++NumExecuted;
+		}
+
+		for (int32 Index = ResolvedStep.FirstFunction; Index < ResolvedStep.FirstFunction + ResolvedStep.NumFunctions; ++Index)
+		{
+			if (FCustomEditorHotkeysBlutilityExtensions::ExecuteUtilityFunction(Functions[Index], &ResolvedStep.Step->ParamValues))
+			{
+				++NumExecuted;
+			}
+		}
+	}
+
+	return NumExecuted;
+}
+
+FName FCustomEditorHotkeysMacros::GetMacroCommandName(FName MacroName)
+{
+	return FName(*FString::Printf(TEXT("Macro_%s"), *MacroName.ToString()));
+}
+
+#undef LOCTEXT_NAMESPACE
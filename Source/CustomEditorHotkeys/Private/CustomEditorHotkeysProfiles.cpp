@@ -0,0 +1,314 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CustomEditorHotkeysProfiles.h"
+#include "CustomEditorHotkeys.h"
+#include "CustomEditorHotkeysCommands.h"
+
+#include "Dom/JsonObject.h"
+#include "Framework/Commands/InputBindingManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+static const EMultipleKeyBindingIndex ChordIndices[] = { EMultipleKeyBindingIndex::Primary, EMultipleKeyBindingIndex::Secondary };
+static const TCHAR* ChordFieldNames[] = { TEXT("Primary"), TEXT("Secondary") };
+
+static FAutoConsoleCommand ExportProfileCommand(
+	TEXT("CustomEditorHotkeys.Profile.Export"),
+	TEXT("Writes the chords of every custom command to a keybinding profile. Usage: CustomEditorHotkeys.Profile.Export <File>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (Args.Num() > 0 && FCustomEditorHotkeysProfiles::ExportProfile(Args[0]))
+			{
+				UE_LOG(LogCustomEditorHotkeys, Display, TEXT("Keybinding profile written to \"%s\"."), *Args[0]);
+			}
+		}));
+
+static FAutoConsoleCommand ImportProfileCommand(
+	TEXT("CustomEditorHotkeys.Profile.Import"),
+	TEXT("Applies a keybinding profile to the custom commands. Usage: CustomEditorHotkeys.Profile.Import <File>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FCustomEditorHotkeysProfiles::FImportResult Result;
+			if (Args.Num() > 0 && FCustomEditorHotkeysProfiles::ImportProfile(Args[0], Result))
+			{
+				UE_LOG(LogCustomEditorHotkeys, Display, TEXT("Applied %d bindings in %.2f ms, %d unknown commands, %d conflicting chords."),
+					Result.NumApplied, Result.Seconds * 1000.0, Result.NumUnknownCommands, Result.Conflicts.Num());
+				FCustomEditorHotkeysProfiles::LogConflicts(Result.Conflicts);
+			}
+		}));
+
+static FAutoConsoleCommand ListConflictsCommand(
+	TEXT("CustomEditorHotkeys.Profile.Conflicts"),
+	TEXT("Lists the chords custom commands share with other commands."),
+	FConsoleCommandDelegate::CreateLambda([]()
+		{
+			TArray<FCustomEditorHotkeysProfiles::FChordConflict> Conflicts;
+			FCustomEditorHotkeysProfiles::FindConflicts(Conflicts);
+			UE_LOG(LogCustomEditorHotkeys, Display, TEXT("%d conflicting chords."), Conflicts.Num());
+			FCustomEditorHotkeysProfiles::LogConflicts(Conflicts);
+		}));
+
+/** Chords are stored the way the editor displays them, e.g. "Ctrl+Shift+F" */
+static FString ChordToString(const FInputChord& Chord)
+{
+	if (!Chord.IsValidChord())
+	{
+		return FString();
+	}
+
+	FString Result;
+	if (Chord.bCtrl)
+	{
+		Result += TEXT("Ctrl+");
+	}
+	if (Chord.bAlt)
+	{
+		Result += TEXT("Alt+");
+	}
+	if (Chord.bShift)
+	{
+		Result += TEXT("Shift+");
+	}
+	if (Chord.bCmd)
+	{
+		Result += TEXT("Cmd+");
+	}
+	return Result + Chord.Key.GetFName().ToString();
+}
+
+static bool ChordFromString(const FString& String, FInputChord& OutChord)
+{
+	OutChord = FInputChord();
+	if (String.IsEmpty())
+	{
+		return true;
+	}
+
+	TArray<FString> Parts;
+	String.ParseIntoArray(Parts, TEXT("+"));
+	if (Parts.Num() == 0)
+	{
+		return false;
+	}
+
+	// Key names never contain a '+' except for the key itself, e.g. "Ctrl++" is not used by the editor
+	const FString KeyName = Parts.Pop();
+	for (const FString& Modifier : Parts)
+	{
+		if (Modifier == TEXT("Ctrl"))
+		{
+			OutChord.bCtrl = true;
+		}
+		else if (Modifier == TEXT("Alt"))
+		{
+			OutChord.bAlt = true;
+		}
+		else if (Modifier == TEXT("Shift"))
+		{
+			OutChord.bShift = true;
+		}
+		else if (Modifier == TEXT("Cmd"))
+		{
+			OutChord.bCmd = true;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	OutChord.Key = FKey(*KeyName);
+	return OutChord.Key.IsValid();
+}
+
+bool FCustomEditorHotkeysProfiles::ExportProfile(const FString& FilePath)
+{
+	TArray<TSharedPtr<FUICommandInfo>> CommandInfos;
+	FInputBindingManager::Get().GetCommandInfosFromContext(FCustomEditorHotkeysCommands::Get().GetContextName(), CommandInfos);
+	CommandInfos.Sort([](const TSharedPtr<FUICommandInfo>& A, const TSharedPtr<FUICommandInfo>& B) { return A->GetCommandName().LexicalLess(B->GetCommandName()); });
+
+	TArray<TSharedPtr<FJsonValue>> Bindings;
+	Bindings.Reserve(CommandInfos.Num());
+
+	for (const TSharedPtr<FUICommandInfo>& CommandInfo : CommandInfos)
+	{
+		TSharedRef<FJsonObject> Binding = MakeShared<FJsonObject>();
+		Binding->SetStringField(TEXT("Command"), CommandInfo->GetCommandName().ToString());
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(ChordIndices); ++Index)
+		{
+			Binding->SetStringField(ChordFieldNames[Index], ChordToString(CommandInfo->GetActiveChord(ChordIndices[Index]).Get()));
+		}
+		Bindings.Add(MakeShared<FJsonValueObject>(Binding));
+	}
+
+	TSharedRef<FJsonObject> Profile = MakeShared<FJsonObject>();
+	Profile->SetArrayField(TEXT("Bindings"), Bindings);
+
+	FString Json;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	if (!FJsonSerializer::Serialize(Profile, Writer))
+	{
+		return false;
+	}
+
+	if (!FFileHelper::SaveStringToFile(Json, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Could not write keybinding profile \"%s\"."), *FilePath);
+		return false;
+	}
+
+	return true;
+}
+
+bool FCustomEditorHotkeysProfiles::ImportProfile(const FString& FilePath, FImportResult& OutResult)
+{
+	OutResult = FImportResult();
+	const double StartTime = FPlatformTime::Seconds();
+
+	FString Json;
+	TSharedPtr<FJsonObject> Profile;
+	if (!FFileHelper::LoadFileToString(Json, *FilePath) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Profile) || !Profile.IsValid())
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Could not read keybinding profile \"%s\"."), *FilePath);
+		return false;
+	}
+
+	FInputBindingManager& BindingManager = FInputBindingManager::Get();
+
+	TArray<TSharedPtr<FUICommandInfo>> CommandInfos;
+	BindingManager.GetCommandInfosFromContext(FCustomEditorHotkeysCommands::Get().GetContextName(), CommandInfos);
+
+	TMap<FName, TSharedPtr<FUICommandInfo>> CommandsByName;
+	CommandsByName.Reserve(CommandInfos.Num());
+	for (const TSharedPtr<FUICommandInfo>& CommandInfo : CommandInfos)
+	{
+		CommandsByName.Add(CommandInfo->GetCommandName(), CommandInfo);
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Bindings = nullptr;
+	if (!Profile->TryGetArrayField(TEXT("Bindings"), Bindings))
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Keybinding profile \"%s\" has no bindings."), *FilePath);
+		return false;
+	}
+
+	// Chords are only set in memory here, the user's key bindings are written once at the end instead of once per command
+	for (const TSharedPtr<FJsonValue>& BindingValue : *Bindings)
+	{
+		const TSharedPtr<FJsonObject>* Binding = nullptr;
+		FString CommandName;
+		if (!BindingValue->TryGetObject(Binding) || !(*Binding)->TryGetStringField(TEXT("Command"), CommandName))
+		{
+			continue;
+		}
+
+		const TSharedPtr<FUICommandInfo>* CommandInfo = CommandsByName.Find(FName(*CommandName));
+		if (!CommandInfo)
+		{
+			++OutResult.NumUnknownCommands;
+			continue;
+		}
+
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(ChordIndices); ++Index)
+		{
+			FString ChordString;
+			FInputChord Chord;
+			if (!(*Binding)->TryGetStringField(ChordFieldNames[Index], ChordString))
+			{
+				continue;
+			}
+
+			if (!ChordFromString(ChordString, Chord))
+			{
+				UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Ignoring invalid chord \"%s\" for \"%s\"."), *ChordString, *CommandName);
+				continue;
+			}
+
+			if ((*CommandInfo)->GetActiveChord(ChordIndices[Index]).Get() != Chord)
+			{
+				(*CommandInfo)->SetActiveChord(Chord, ChordIndices[Index]);
+			}
+		}
+
+		++OutResult.NumApplied;
+	}
+
+	BindingManager.SaveInputBindings();
+
+	FindConflicts(OutResult.Conflicts);
+	OutResult.Seconds = FPlatformTime::Seconds() - StartTime;
+	return true;
+}
+
+void FCustomEditorHotkeysProfiles::FindConflicts(TArray<FChordConflict>& OutConflicts)
+{
+	OutConflicts.Reset();
+
+	FInputBindingManager& BindingManager = FInputBindingManager::Get();
+	const FName CustomContextName = FCustomEditorHotkeysCommands::Get().GetContextName();
+
+	TArray<TSharedPtr<FBindingContext>> Contexts;
+	BindingManager.GetKnownInputContexts(Contexts);
+
+	struct FBoundCommand
+	{
+		FName Context;
+		FName Command;
+	};
+
+	TMap<FInputChord, TArray<FBoundCommand, TInlineAllocator<2>>> ChordIndex;
+	TArray<TSharedPtr<FUICommandInfo>> CommandInfos;
+
+	for (const TSharedPtr<FBindingContext>& Context : Contexts)
+	{
+		const FName ContextName = Context->GetContextName();
+
+		CommandInfos.Reset();
+		BindingManager.GetCommandInfosFromContext(ContextName, CommandInfos);
+
+		for (const TSharedPtr<FUICommandInfo>& CommandInfo : CommandInfos)
+		{
+			for (EMultipleKeyBindingIndex BindingIndex : ChordIndices)
+			{
+				const FInputChord& Chord = CommandInfo->GetActiveChord(BindingIndex).Get();
+				if (Chord.IsValidChord())
+				{
+					ChordIndex.FindOrAdd(Chord).Add({ ContextName, CommandInfo->GetCommandName() });
+				}
+			}
+		}
+	}
+
+	for (TPair<FInputChord, TArray<FBoundCommand, TInlineAllocator<2>>>& Pair : ChordIndex)
+	{
+		if (Pair.Value.Num() < 2 || !Pair.Value.ContainsByPredicate([CustomContextName](const FBoundCommand& Bound) { return Bound.Context == CustomContextName; }))
+		{
+			continue;
+		}
+
+		FChordConflict& Conflict = OutConflicts.AddDefaulted_GetRef();
+		Conflict.Chord = Pair.Key;
+		for (const FBoundCommand& Bound : Pair.Value)
+		{
+			Conflict.Commands.Emplace(Bound.Context, Bound.Command);
+		}
+	}
+
+	OutConflicts.Sort([](const FChordConflict& A, const FChordConflict& B) { return ChordToString(A.Chord) < ChordToString(B.Chord); });
+}
+
+void FCustomEditorHotkeysProfiles::LogConflicts(const TArray<FChordConflict>& Conflicts)
+{
+	for (const FChordConflict& Conflict : Conflicts)
+	{
+		TArray<FString> CommandNames;
+		for (const TPair<FName, FName>& Command : Conflict.Commands)
+		{
+			CommandNames.Add(FString::Printf(TEXT("%s.%s"), *Command.Key.ToString(), *Command.Value.ToString()));
+		}
+
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Chord %s is bound to %s"), *ChordToString(Conflict.Chord), *FString::Join(CommandNames, TEXT(", ")));
+	}
+}
@@ -0,0 +1,385 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CustomEditorHotkeysPythonScripts.h"
+#include "CustomEditorHotkeys.h"
+#include "CustomEditorHotkeysMacros.h"
+#include "CustomEditorHotkeysSettings.h"
+
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#include "IPythonScriptPlugin.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+
+/** Name the cache module is registered under in sys.modules */
+static const TCHAR* PythonCacheModuleName = TEXT("_custom_editor_hotkeys");
+
+/** Python side of the code cache, each script's scope is kept from its first run until it is invalidated */
+static const TCHAR* PythonCacheModuleSource = TEXT(R"PY(
+_scopes = {}
+
+def run(path, function):
+	scope = _scopes.get(path)
+	if scope is None:
+		with open(path, 'r', encoding='utf-8') as script:
+			code = compile(script.read(), path, 'exec')
+		scope = {'__name__': '__custom_editor_hotkeys__', '__file__': path}
+		exec(code, scope)
+		_scopes[path] = scope
+	scope[function]()
+
+def invalidate(path=None):
+	if path is None:
+		_scopes.clear()
+	else:
+		_scopes.pop(path, None)
+)PY");
+
+/** The Python plugin is optional, returns null when it isn't enabled in the project or was built without Python */
+static IPythonScriptPlugin* GetPythonScriptPlugin()
+{
+	static const FName PythonScriptPluginName(TEXT("PythonScriptPlugin"));
+	IPythonScriptPlugin* PythonScriptPlugin = FModuleManager::Get().ModuleExists(*PythonScriptPluginName.ToString())
+		? FModuleManager::LoadModulePtr<IPythonScriptPlugin>(PythonScriptPluginName)
+		: nullptr;
+	return PythonScriptPlugin && PythonScriptPlugin->IsPythonAvailable() ? PythonScriptPlugin : nullptr;
+}
+
+static FString QuotePythonString(const FString& Value)
+{
+	return FString::Printf(TEXT("'%s'"), *Value.ReplaceCharWithEscapedChar());
+}
+
+static FString GetScriptDirectory(const FDirectoryPath& DirectoryPath)
+{
+	FString Directory = DirectoryPath.Path;
+	if (FPaths::IsRelative(Directory))
+	{
+		Directory = FPaths::ProjectDir() / Directory;
+	}
+
+	Directory = FPaths::ConvertRelativePathToFull(Directory);
+	FPaths::NormalizeDirectoryName(Directory);
+	return Directory;
+}
+
+bool FCustomEditorHotkeysPythonScripts::bCodeCacheInstalled = false;
+
+TSharedPtr<FCustomEditorHotkeysPythonScripts> FCustomEditorHotkeysPythonScripts::Instance = nullptr;
+
+void FCustomEditorHotkeysPythonScripts::Initialize()
+{
+	Shutdown();
+
+	const UCustomEditorHotkeysSettings* Settings = GetDefault<UCustomEditorHotkeysSettings>();
+	if (!IsPythonAvailable())
+	{
+		if (Settings->LevelEditorPythonScriptDirectories.Num() > 0 || Settings->ContentBrowserPythonScriptDirectories.Num() > 0)
+		{
+			UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Python script directories are set but Python is not available, enable the Python Editor Script Plugin to use script commands."));
+		}
+		return;
+	}
+
+	TSharedPtr<FCustomEditorHotkeysPythonScripts> NewInstance = MakeShareable(new FCustomEditorHotkeysPythonScripts());
+	NewInstance->Rescan();
+	NewInstance->InvalidateCodeCache(FString());
+
+	for (const FDirectoryPath& DirectoryPath : Settings->LevelEditorPythonScriptDirectories)
+	{
+		NewInstance->WatchDirectory(GetScriptDirectory(DirectoryPath));
+	}
+	for (const FDirectoryPath& DirectoryPath : Settings->ContentBrowserPythonScriptDirectories)
+	{
+		NewInstance->WatchDirectory(GetScriptDirectory(DirectoryPath));
+	}
+
+	Instance = NewInstance;
+}
+
+void FCustomEditorHotkeysPythonScripts::Shutdown()
+{
+	Instance.Reset();
+}
+
+bool FCustomEditorHotkeysPythonScripts::IsPythonAvailable()
+{
+	return GetPythonScriptPlugin() != nullptr;
+}
+
+FCustomEditorHotkeysPythonScripts& FCustomEditorHotkeysPythonScripts::Get()
+{
+	return *Instance;
+}
+
+FCustomEditorHotkeysPythonScripts::~FCustomEditorHotkeysPythonScripts()
+{
+	if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+	{
+		if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+		{
+			for (const TPair<FString, FDelegateHandle>& Watcher : DirectoryWatchers)
+			{
+				DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(Watcher.Key, Watcher.Value);
+			}
+		}
+	}
+}
+
+const FCustomEditorHotkeysPythonScripts::FEntryPoint* FCustomEditorHotkeysPythonScripts::FindEntryPoint(FName CommandName) const
+{
+	const int32* Index = EntryPointIndices.Find(CommandName);
+	return Index ? &EntryPoints[*Index] : nullptr;
+}
+
+bool FCustomEditorHotkeysPythonScripts::RunScriptCommand(FName CommandName)
+{
+	const FEntryPoint* EntryPoint = IsInitialized() ? Get().FindEntryPoint(CommandName) : nullptr;
+	if (!EntryPoint)
+	{
+		return false;
+	}
+
+	IPythonScriptPlugin* PythonScriptPlugin = GetPythonScriptPlugin();
+	if (!PythonScriptPlugin)
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Cannot run \"%s\": Python is not available."), *CommandName.ToString());
+		return false;
+	}
+
+	if (!Get().EnsureCodeCache())
+	{
+		return false;
+	}
+
+	FPythonCommandEx PythonCommand;
+	PythonCommand.ExecutionMode = EPythonCommandExecutionMode::ExecuteStatement;
+	PythonCommand.Command = FString::Printf(TEXT("__import__('%s').run(%s, %s)"), PythonCacheModuleName, *QuotePythonString(EntryPoint->ScriptPath), *QuotePythonString(EntryPoint->FunctionName));
+
+	if (!PythonScriptPlugin->ExecPythonCommandEx(PythonCommand))
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("\"%s\" failed: %s"), *CommandName.ToString(), *PythonCommand.CommandResult);
+		return false;
+	}
+
+	return true;
+}
+
+void FCustomEditorHotkeysPythonScripts::ExecuteScriptCommandByName(FName CommandName)
+{
+	const FEntryPoint* EntryPoint = IsInitialized() ? Get().FindEntryPoint(CommandName) : nullptr;
+	const bool bContentBrowserCommand = EntryPoint && EntryPoint->bContentBrowserCommand;
+
+	// Scripts take no parameters, the step only names the command
+	FCustomEditorHotkeysMacros::FScopedRecordedPress RecordedPress;
+	const bool bExecuted = RunScriptCommand(CommandName);
+	FCustomEditorHotkeysMacros::RecordCommand(CommandName, bContentBrowserCommand, bExecuted);
+}
+
+bool FCustomEditorHotkeysPythonScripts::Rescan()
+{
+	TSet<FName> PreviousCommands;
+	EntryPointIndices.GetKeys(PreviousCommands);
+
+	EntryPoints.Reset();
+	EntryPointIndices.Reset();
+
+	const UCustomEditorHotkeysSettings* Settings = GetDefault<UCustomEditorHotkeysSettings>();
+
+	auto ScanDirectories = [this](const TArray<FDirectoryPath>& Directories, bool bContentBrowserCommand)
+	{
+		for (const FDirectoryPath& DirectoryPath : Directories)
+		{
+			TArray<FString> ScriptFiles;
+			IFileManager::Get().FindFilesRecursive(ScriptFiles, *GetScriptDirectory(DirectoryPath), TEXT("*.py"), true, false);
+			ScriptFiles.Sort();
+
+			for (const FString& ScriptFile : ScriptFiles)
+			{
+				ScanScript(ScriptFile, bContentBrowserCommand);
+			}
+		}
+	};
+
+	ScanDirectories(Settings->LevelEditorPythonScriptDirectories, false);
+	ScanDirectories(Settings->ContentBrowserPythonScriptDirectories, true);
+
+	if (PreviousCommands.Num() != EntryPointIndices.Num())
+	{
+		return true;
+	}
+
+	for (const TPair<FName, int32>& EntryPoint : EntryPointIndices)
+	{
+		if (!PreviousCommands.Contains(EntryPoint.Key))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FCustomEditorHotkeysPythonScripts::ScanScript(const FString& ScriptPath, bool bContentBrowserCommand)
+{
+	const FString ScriptName = FPaths::GetBaseFilename(ScriptPath);
+
+	// Private modules such as __init__.py only hold helpers
+	if (ScriptName.StartsWith(TEXT("_")))
+	{
+		return;
+	}
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *ScriptPath))
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Could not read Python script \"%s\"."), *ScriptPath);
+		return;
+	}
+
+	FString NormalizedPath = ScriptPath;
+	FPaths::NormalizeFilename(NormalizedPath);
+
+	// A plain text scan is enough to find entry points and keeps Python out of the refresh, only unindented
+	// "def name():" lines are considered
+	for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		const FString& Line = Lines[LineIndex];
+		if (!Line.StartsWith(TEXT("def ")))
+		{
+			continue;
+		}
+
+		FString FunctionName;
+		FString Arguments;
+		if (!Line.Mid(4).Split(TEXT("("), &FunctionName, &Arguments))
+		{
+			continue;
+		}
+
+		FunctionName.TrimStartAndEndInline();
+		if (FunctionName.IsEmpty() || FunctionName.StartsWith(TEXT("_")) || !Arguments.TrimStart().StartsWith(TEXT(")")))
+		{
+			continue;
+		}
+
+		FEntryPoint EntryPoint;
+		EntryPoint.CommandName = FName(*FString::Printf(TEXT("Py_%s_%s"), *ScriptName, *FunctionName));
+		EntryPoint.ScriptPath = NormalizedPath;
+		EntryPoint.FunctionName = FunctionName;
+		EntryPoint.bContentBrowserCommand = bContentBrowserCommand;
+
+		const FString NextLine = Lines.IsValidIndex(LineIndex + 1) ? Lines[LineIndex + 1].TrimStartAndEnd() : FString();
+		if (NextLine.StartsWith(TEXT("\"\"\"")) || NextLine.StartsWith(TEXT("'''")))
+		{
+			FString Docstring = NextLine.Mid(3);
+			const int32 ClosingQuotes = Docstring.Find(NextLine.Left(3));
+			if (ClosingQuotes != INDEX_NONE)
+			{
+				Docstring.LeftInline(ClosingQuotes);
+			}
+			EntryPoint.Description = Docstring.TrimStartAndEnd();
+		}
+		if (EntryPoint.Description.IsEmpty())
+		{
+			EntryPoint.Description = FString::Printf(TEXT("Runs %s() from %s"), *FunctionName, *FPaths::GetCleanFilename(ScriptPath));
+		}
+
+		if (EntryPointIndices.Contains(EntryPoint.CommandName))
+		{
+			UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Duplicate Python command \"%s\" in \"%s\", only the first one is registered."), *EntryPoint.CommandName.ToString(), *ScriptPath);
+			continue;
+		}
+
+		EntryPointIndices.Add(EntryPoint.CommandName, EntryPoints.Num());
+		EntryPoints.Add(MoveTemp(EntryPoint));
+	}
+}
+
+void FCustomEditorHotkeysPythonScripts::WatchDirectory(const FString& Directory)
+{
+	if (!IFileManager::Get().DirectoryExists(*Directory) || DirectoryWatchers.ContainsByPredicate([&Directory](const TPair<FString, FDelegateHandle>& Watcher) { return Watcher.Key == Directory; }))
+	{
+		return;
+	}
+
+	FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+	if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get())
+	{
+		FDelegateHandle Handle;
+		if (DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(Directory, IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FCustomEditorHotkeysPythonScripts::OnDirectoryChanged), Handle))
+		{
+			DirectoryWatchers.Emplace(Directory, Handle);
+		}
+	}
+}
+
+void FCustomEditorHotkeysPythonScripts::OnDirectoryChanged(const TArray<FFileChangeData>& FileChanges)
+{
+	bool bScriptsChanged = false;
+	for (const FFileChangeData& FileChange : FileChanges)
+	{
+		if (FPaths::GetExtension(FileChange.Filename) == TEXT("py"))
+		{
+			FString ScriptPath = FPaths::ConvertRelativePathToFull(FileChange.Filename);
+			FPaths::NormalizeFilename(ScriptPath);
+			InvalidateCodeCache(ScriptPath);
+			bScriptsChanged = true;
+		}
+	}
+
+	// Edits that only touch function bodies don't need new commands, the next key press recompiles the script
+	if (bScriptsChanged && Rescan())
+	{
+		FModuleManager::GetModuleChecked<FCustomEditorHotkeysModule>(TEXT("CustomEditorHotkeys")).PluginButtonClicked();
+	}
+}
+
+bool FCustomEditorHotkeysPythonScripts::EnsureCodeCache()
+{
+	if (bCodeCacheInstalled)
+	{
+		return true;
+	}
+
+	IPythonScriptPlugin* PythonScriptPlugin = GetPythonScriptPlugin();
+	if (!PythonScriptPlugin)
+	{
+		return false;
+	}
+
+	FPythonCommandEx PythonCommand;
+	PythonCommand.ExecutionMode = EPythonCommandExecutionMode::ExecuteFile;
+	PythonCommand.FileExecutionScope = EPythonFileExecutionScope::Private;
+	PythonCommand.Command = FString::Printf(TEXT("import sys, types\nmodule = types.ModuleType('%s')\nexec(%s, module.__dict__)\nsys.modules[module.__name__] = module\n"),
+		PythonCacheModuleName, *QuotePythonString(PythonCacheModuleSource));
+
+	bCodeCacheInstalled = PythonScriptPlugin->ExecPythonCommandEx(PythonCommand);
+	if (!bCodeCacheInstalled)
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Could not set up the Python code cache: %s"), *PythonCommand.CommandResult);
+	}
+
+	return bCodeCacheInstalled;
+}
+
+void FCustomEditorHotkeysPythonScripts::InvalidateCodeCache(const FString& ScriptPath)
+{
+	// Nothing was compiled yet if the cache module isn't there
+	if (!bCodeCacheInstalled)
+	{
+		return;
+	}
+
+	if (IPythonScriptPlugin* PythonScriptPlugin = GetPythonScriptPlugin())
+	{
+		FPythonCommandEx PythonCommand;
+		PythonCommand.ExecutionMode = EPythonCommandExecutionMode::ExecuteStatement;
+		PythonCommand.Command = ScriptPath.IsEmpty()
+			? FString::Printf(TEXT("__import__('%s').invalidate()"), PythonCacheModuleName)
+			: FString::Printf(TEXT("__import__('%s').invalidate(%s)"), PythonCacheModuleName, *QuotePythonString(ScriptPath));
+		PythonScriptPlugin->ExecPythonCommandEx(PythonCommand);
+	}
+}
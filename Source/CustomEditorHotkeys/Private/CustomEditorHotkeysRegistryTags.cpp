@@ -0,0 +1,143 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CustomEditorHotkeysRegistryTags.h"
+#include "CustomEditorHotkeys.h"
+#include "CustomEditorHotkeysCommands.h"
+
+#include "ActorActionUtility.h"
+#include "AssetActionUtility.h"
+#include "AssetRegistry/AssetData.h"
+#include "Dom/JsonObject.h"
+#include "EditorUtilityBlueprint.h"
+#include "EditorUtilityObject.h"
+#include "Misc/PackageName.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+const FName FCustomEditorHotkeysRegistryTags::NAME_HotkeyFunctionsTag(TEXT("CustomEditorHotkeysFunctions"));
+
+FDelegateHandle FCustomEditorHotkeysRegistryTags::ExtraObjectTagsHandle;
+
+/** Bumped whenever the tag layout changes, older tags are ignored and their blueprints loaded instead */
+static const int32 HotkeyFunctionsTagVersion = 1;
+
+void FCustomEditorHotkeysRegistryTags::Register()
+{
+	if (!ExtraObjectTagsHandle.IsValid())
+	{
+		ExtraObjectTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTags.AddStatic(&FCustomEditorHotkeysRegistryTags::OnGetExtraObjectTags);
+	}
+}
+
+void FCustomEditorHotkeysRegistryTags::Unregister()
+{
+	UObject::FAssetRegistryTag::OnGetExtraObjectTags.Remove(ExtraObjectTagsHandle);
+	ExtraObjectTagsHandle.Reset();
+}
+
+void FCustomEditorHotkeysRegistryTags::OnGetExtraObjectTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& InOutTags)
+{
+	// Called for every object the registry gathers tags from, anything but a compiled utility blueprint is skipped right away
+	const UEditorUtilityBlueprint* Blueprint = Cast<UEditorUtilityBlueprint>(Object);
+	UClass* UtilityClass = Blueprint ? Blueprint->GeneratedClass.Get() : nullptr;
+	if (!UtilityClass || !(UtilityClass->IsChildOf(UActorActionUtility::StaticClass()) || UtilityClass->IsChildOf(UAssetActionUtility::StaticClass())))
+	{
+		return;
+	}
+
+	UEditorUtilityObject* DefaultObject = Cast<UEditorUtilityObject>(UtilityClass->GetDefaultObject());
+	if (!DefaultObject)
+	{
+		return;
+	}
+
+	UClass* SupportedClass = nullptr;
+	{
+		FEditorScriptExecutionGuard ScriptGuard;
+		if (UActorActionUtility* ActorUtility = Cast<UActorActionUtility>(DefaultObject))
+		{
+			SupportedClass = ActorUtility->GetSupportedClass();
+		}
+		else if (UAssetActionUtility* AssetUtility = Cast<UAssetActionUtility>(DefaultObject))
+		{
+			SupportedClass = AssetUtility->GetSupportedClass();
+		}
+	}
+
+	TArray<FCustomEditorHotkeysBlutilityExtensions::FFunctionAndUtil> UtilityFunctions;
+	FCustomEditorHotkeysBlutilityExtensions::GetUtilityFunctions(DefaultObject, UtilityFunctions);
+
+	TArray<TSharedPtr<FJsonValue>> Functions;
+	Functions.Reserve(UtilityFunctions.Num());
+	for (const FCustomEditorHotkeysBlutilityExtensions::FFunctionAndUtil& UtilityFunction : UtilityFunctions)
+	{
+		const UFunction* Function = UtilityFunction.Function;
+
+		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetStringField(TEXT("Name"), Function->GetName());
+		Entry->SetStringField(TEXT("DisplayName"), Function->GetDisplayNameText().ToString());
+		Entry->SetNumberField(TEXT("NumParms"), Function->NumParms);
+		Entry->SetStringField(TEXT("Description"), Function->GetDesc());
+		Entry->SetStringField(TEXT("Icon"), Function->GetMetaData(FCustomEditorHotkeysBlutilityExtensions::NAME_HotkeyIcon));
+		Functions.Add(MakeShared<FJsonValueObject>(Entry));
+	}
+
+	TSharedRef<FJsonObject> Tag = MakeShared<FJsonObject>();
+	Tag->SetNumberField(TEXT("Version"), HotkeyFunctionsTagVersion);
+	Tag->SetStringField(TEXT("SupportedClass"), SupportedClass ? SupportedClass->GetPathName() : FString());
+	Tag->SetArrayField(TEXT("Functions"), Functions);
+
+	FString Json;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+	if (FJsonSerializer::Serialize(Tag, Writer))
+	{
+		InOutTags.Add(UObject::FAssetRegistryTag(NAME_HotkeyFunctionsTag, MoveTemp(Json), UObject::FAssetRegistryTag::TT_Hidden));
+	}
+}
+
+bool FCustomEditorHotkeysRegistryTags::ReadTag(const FAssetData& Asset, FTaggedUtility& OutUtility)
+{
+	FString Json;
+	FString GeneratedClassPath;
+	if (!Asset.GetTagValue(NAME_HotkeyFunctionsTag, Json) || !Asset.GetTagValue(FBlueprintTags::GeneratedClassPath, GeneratedClassPath))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Tag;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Tag) || !Tag.IsValid())
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("\"%s\" has an unreadable hotkey functions tag, it will be loaded instead."), *Asset.GetObjectPathString());
+		return false;
+	}
+
+	int32 Version = 0;
+	const TArray<TSharedPtr<FJsonValue>>* Functions = nullptr;
+	if (!Tag->TryGetNumberField(TEXT("Version"), Version) || Version != HotkeyFunctionsTagVersion || !Tag->TryGetArrayField(TEXT("Functions"), Functions))
+	{
+		return false;
+	}
+
+	OutUtility.UtilityClass = FSoftClassPath(FPackageName::ExportTextPathToObjectPath(GeneratedClassPath));
+	OutUtility.SupportedClass = FSoftClassPath(Tag->GetStringField(TEXT("SupportedClass")));
+	OutUtility.Functions.Reset(Functions->Num());
+
+	for (const TSharedPtr<FJsonValue>& FunctionValue : *Functions)
+	{
+		const TSharedPtr<FJsonObject>* Entry = nullptr;
+		if (!FunctionValue->TryGetObject(Entry))
+		{
+			continue;
+		}
+
+		FTaggedFunction& Function = OutUtility.Functions.AddDefaulted_GetRef();
+		Function.Name = FName(*(*Entry)->GetStringField(TEXT("Name")));
+		Function.DisplayName = (*Entry)->GetStringField(TEXT("DisplayName"));
+		Function.NumParms = (*Entry)->GetIntegerField(TEXT("NumParms"));
+		Function.Description = (*Entry)->GetStringField(TEXT("Description"));
+		Function.IconPath = (*Entry)->GetStringField(TEXT("Icon"));
+	}
+
+	return true;
+}
@@ -0,0 +1,518 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CustomEditorHotkeysRemoteTrigger.h"
+#include "CustomEditorHotkeys.h"
+#include "CustomEditorHotkeysCommands.h"
+#include "CustomEditorHotkeysDispatch.h"
+#include "CustomEditorHotkeysPythonScripts.h"
+#include "CustomEditorHotkeysSettings.h"
+
+#include "Common/TcpListener.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+
+/** Requests without a trailing newline are dropped once they grow past this */
+static const int32 MaxRemoteRequestLength = 64 * 1024;
+
+TSharedPtr<FCustomEditorHotkeysRemoteTrigger> FCustomEditorHotkeysRemoteTrigger::Instance = nullptr;
+
+static FAutoConsoleCommand RemoteTriggerSendCommand(
+	TEXT("CustomEditorHotkeys.Remote.Send"),
+	TEXT("Queues a remote trigger request as if a local client had sent it and logs the reply. Usage: CustomEditorHotkeys.Remote.Send RUN <Command> [ACTORS ...] [ASSETS ...] [PARAM Name=Value ...]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (!FCustomEditorHotkeysRemoteTrigger::IsRunning())
+			{
+				UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("The remote trigger is disabled, enable it in the Custom Editor Hotkeys editor preferences."));
+				return;
+			}
+
+			FCustomEditorHotkeysRemoteTrigger::Get().SubmitLocal(FString::Join(Args, TEXT(" ")), [](const FString& Reply)
+				{
+					UE_LOG(LogCustomEditorHotkeys, Display, TEXT("Remote trigger reply: %s"), *Reply);
+				});
+		}));
+
+void FCustomEditorHotkeysRemoteTrigger::Initialize()
+{
+	Shutdown();
+
+	const UCustomEditorHotkeysSettings* Settings = GetDefault<UCustomEditorHotkeysSettings>();
+	if (Settings->bEnableRemoteTrigger)
+	{
+		TSharedPtr<FCustomEditorHotkeysRemoteTrigger> NewInstance = MakeShareable(new FCustomEditorHotkeysRemoteTrigger(Settings->RemoteTriggerPort, Settings->MaxRemoteRequestsPerTick));
+		if (NewInstance->Start())
+		{
+			Instance = NewInstance;
+		}
+	}
+}
+
+void FCustomEditorHotkeysRemoteTrigger::Shutdown()
+{
+	Instance.Reset();
+}
+
+FCustomEditorHotkeysRemoteTrigger& FCustomEditorHotkeysRemoteTrigger::Get()
+{
+	return *Instance;
+}
+
+FCustomEditorHotkeysRemoteTrigger::FCustomEditorHotkeysRemoteTrigger(int32 InPort, int32 InMaxRequestsPerTick)
+	: Port(InPort)
+	, MaxRequestsPerTick(FMath::Max(InMaxRequestsPerTick, 1))
+{
+}
+
+FCustomEditorHotkeysRemoteTrigger::~FCustomEditorHotkeysRemoteTrigger()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	// Stop accepting first so no socket is handed over while the worker shuts down
+	Listener.Reset();
+
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	FSocket* Socket = nullptr;
+	while (AcceptedSockets.Dequeue(Socket))
+	{
+		Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+	}
+}
+
+FString FCustomEditorHotkeysRemoteTrigger::GetTokenFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("CustomEditorHotkeys") / TEXT("RemoteTrigger.token");
+}
+
+bool FCustomEditorHotkeysRemoteTrigger::Start()
+{
+	// Only bind to loopback, the endpoint runs arbitrary editor utilities
+	const FIPv4Endpoint Endpoint(FIPv4Address(127, 0, 0, 1), static_cast<uint16>(Port));
+
+	// Loopback alone doesn't keep out a web page posting to the port, clients prove they can read the project's files instead
+	SessionToken = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+	if (!FFileHelper::SaveStringToFile(SessionToken, *GetTokenFilePath()))
+	{
+		UE_LOG(LogCustomEditorHotkeys, Error, TEXT("Remote trigger could not write its session token to \"%s\"."), *GetTokenFilePath());
+		return false;
+	}
+
+	Listener = MakeUnique<FTcpListener>(Endpoint);
+	if (!Listener->IsActive())
+	{
+		UE_LOG(LogCustomEditorHotkeys, Error, TEXT("Remote trigger could not listen on %s."), *Endpoint.ToString());
+		Listener.Reset();
+		return false;
+	}
+	Listener->OnConnectionAccepted().BindRaw(this, &FCustomEditorHotkeysRemoteTrigger::OnConnectionAccepted);
+
+	Thread = FRunnableThread::Create(this, TEXT("CustomEditorHotkeysRemoteTrigger"));
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FCustomEditorHotkeysRemoteTrigger::Tick));
+
+	UE_LOG(LogCustomEditorHotkeys, Log, TEXT("Remote trigger listening on %s, session token in \"%s\"."), *Endpoint.ToString(), *GetTokenFilePath());
+	return true;
+}
+
+void FCustomEditorHotkeysRemoteTrigger::SubmitLocal(const FString& Line, TFunction<void(const FString&)> OnReply)
+{
+	Requests.Enqueue({ INDEX_NONE, Line, FPlatformTime::Seconds(), MoveTemp(OnReply) });
+}
+
+bool FCustomEditorHotkeysRemoteTrigger::OnConnectionAccepted(FSocket* Socket, const FIPv4Endpoint& Endpoint)
+{
+	AcceptedSockets.Enqueue(Socket);
+	return true;
+}
+
+uint32 FCustomEditorHotkeysRemoteTrigger::Run()
+{
+	while (!bStopping)
+	{
+		FSocket* AcceptedSocket = nullptr;
+		while (AcceptedSockets.Dequeue(AcceptedSocket))
+		{
+			AcceptedSocket->SetNonBlocking(true);
+			Connections.Add({ NextConnectionId++, AcceptedSocket });
+		}
+
+		for (FConnection& Connection : Connections)
+		{
+			ReadConnection(Connection);
+		}
+
+		FReply Reply;
+		while (Replies.Dequeue(Reply))
+		{
+			FConnection* Connection = Connections.FindByPredicate([&Reply](const FConnection& Candidate) { return Candidate.Id == Reply.ConnectionId; });
+			if (!Connection || !Connection->Socket)
+			{
+				continue;
+			}
+
+			SendLine(*Connection, Reply.Line);
+			if (Reply.bClose)
+			{
+				CloseConnection(*Connection);
+			}
+		}
+
+		Connections.RemoveAllSwap([](const FConnection& Connection) { return Connection.Socket == nullptr; });
+
+		FPlatformProcess::Sleep(0.002f);
+	}
+
+	for (FConnection& Connection : Connections)
+	{
+		CloseConnection(Connection);
+	}
+	Connections.Empty();
+
+	return 0;
+}
+
+void FCustomEditorHotkeysRemoteTrigger::Stop()
+{
+	bStopping = true;
+}
+
+void FCustomEditorHotkeysRemoteTrigger::ReadConnection(FConnection& Connection)
+{
+	// Nothing after an unknown request is read, the connection is closed once the game thread answered what came before it
+	if (Connection.bRejected)
+	{
+		return;
+	}
+
+	uint32 PendingSize = 0;
+	while (Connection.Socket->HasPendingData(PendingSize) && PendingSize > 0)
+	{
+		const int32 Offset = Connection.PendingInput.Num();
+		Connection.PendingInput.AddUninitialized(PendingSize);
+
+		int32 BytesRead = 0;
+		if (!Connection.Socket->Recv(Connection.PendingInput.GetData() + Offset, PendingSize, BytesRead))
+		{
+			CloseConnection(Connection);
+			return;
+		}
+		Connection.PendingInput.SetNum(Offset + BytesRead, false);
+	}
+
+	// Every complete line is a request, a burst of them is queued in one go and run in order on the game thread
+	const double ReceivedTime = FPlatformTime::Seconds();
+	int32 LineStart = 0;
+	for (int32 Index = 0; Index < Connection.PendingInput.Num(); ++Index)
+	{
+		if (Connection.PendingInput[Index] != '\n')
+		{
+			continue;
+		}
+
+		int32 LineEnd = Index;
+		if (LineEnd > LineStart && Connection.PendingInput[LineEnd - 1] == '\r')
+		{
+			--LineEnd;
+		}
+
+		FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Connection.PendingInput.GetData() + LineStart), LineEnd - LineStart);
+		FString Line(Converter.Length(), Converter.Get());
+		LineStart = Index + 1;
+
+		// The first line has to be the session token, anything else (e.g. an HTTP request line) drops the connection
+		// before any of what follows is looked at
+		const TCHAR* Stream = *Line;
+		FString Verb;
+		FParse::Token(Stream, Verb, false);
+
+		if (!Connection.bAuthenticated)
+		{
+			FString Token;
+			if (Verb != TEXT("AUTH") || !FParse::Token(Stream, Token, false) || Token != SessionToken)
+			{
+				SendLine(Connection, TEXT("ERR - Unauthorized"));
+				CloseConnection(Connection);
+				return;
+			}
+
+			Connection.bAuthenticated = true;
+			SendLine(Connection, TEXT("AUTHED"));
+			if (!Connection.Socket)
+			{
+				return;
+			}
+			continue;
+		}
+
+		// Unknown requests are still queued, so the game thread answers them in order after the requests before them
+		Requests.Enqueue({ Connection.Id, MoveTemp(Line), ReceivedTime, nullptr });
+
+		if (Verb != TEXT("PING") && Verb != TEXT("RUN"))
+		{
+			Connection.bRejected = true;
+			Connection.PendingInput.Empty();
+			return;
+		}
+	}
+	Connection.PendingInput.RemoveAt(0, LineStart, false);
+
+	if (Connection.PendingInput.Num() > MaxRemoteRequestLength || Connection.Socket->GetConnectionState() != SCS_Connected)
+	{
+		CloseConnection(Connection);
+	}
+}
+
+void FCustomEditorHotkeysRemoteTrigger::SendLine(FConnection& Connection, const FString& Line)
+{
+	FTCHARToUTF8 Utf8Line(*(Line + TEXT("\n")));
+	const uint8* Data = reinterpret_cast<const uint8*>(Utf8Line.Get());
+
+	for (int32 Offset = 0; Offset < Utf8Line.Length() && Connection.Socket;)
+	{
+		int32 BytesSent = 0;
+		if (!Connection.Socket->Send(Data + Offset, Utf8Line.Length() - Offset, BytesSent))
+		{
+			CloseConnection(Connection);
+			break;
+		}
+		Offset += BytesSent;
+	}
+}
+
+void FCustomEditorHotkeysRemoteTrigger::CloseConnection(FConnection& Connection)
+{
+	if (Connection.Socket)
+	{
+		Connection.Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Connection.Socket);
+		Connection.Socket = nullptr;
+
+		// Queued behind every request of the connection, the game thread can forget it once this comes through
+		if (Connection.bAuthenticated)
+		{
+			FRequest ClosedMarker{ Connection.Id, FString(), FPlatformTime::Seconds(), nullptr };
+			ClosedMarker.bConnectionClosed = true;
+			Requests.Enqueue(MoveTemp(ClosedMarker));
+		}
+	}
+}
+
+bool FCustomEditorHotkeysRemoteTrigger::Tick(float DeltaTime)
+{
+	FRequest Request;
+	for (int32 NumProcessed = 0; NumProcessed < MaxRequestsPerTick && Requests.Dequeue(Request); ++NumProcessed)
+	{
+		if (Request.bConnectionClosed)
+		{
+			RejectedConnections.Remove(Request.ConnectionId);
+			continue;
+		}
+
+		// Requests queued behind a malformed one are never run, the worker closes their connection with the reply
+		if (Request.ConnectionId != INDEX_NONE && RejectedConnections.Contains(Request.ConnectionId))
+		{
+			continue;
+		}
+
+		bool bMalformed = false;
+		FString Reply = ProcessRequest(Request, bMalformed);
+
+		if (Request.LocalReply)
+		{
+			Request.LocalReply(Reply);
+		}
+		else
+		{
+			if (bMalformed)
+			{
+				RejectedConnections.Add(Request.ConnectionId);
+			}
+			Replies.Enqueue({ Request.ConnectionId, MoveTemp(Reply), bMalformed });
+		}
+	}
+
+	return true;
+}
+
+FString FCustomEditorHotkeysRemoteTrigger::ProcessRequest(const FRequest& Request, bool& bOutMalformed) const
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const TCHAR* Stream = *Request.Line;
+
+	// Only cleared again once the request parsed
+	bOutMalformed = true;
+
+	FString Verb;
+	if (!FParse::Token(Stream, Verb, false))
+	{
+		return TEXT("ERR - EmptyRequest");
+	}
+
+	if (Verb == TEXT("PING"))
+	{
+		bOutMalformed = false;
+		return TEXT("PONG");
+	}
+
+	FString CommandName;
+	if (Verb != TEXT("RUN") || !FParse::Token(Stream, CommandName, false))
+	{
+		return TEXT("ERR - UnknownRequest");
+	}
+
+	enum class ETokenList { None, Actors, Assets, Params };
+	ETokenList CurrentList = ETokenList::None;
+
+	TArray<FString> ActorPaths;
+	TArray<FString> AssetPaths;
+	TMap<FName, FString> ParamValues;
+
+	FString Token;
+	while (FParse::Token(Stream, Token, false))
+	{
+		if (Token == TEXT("ACTORS"))
+		{
+			CurrentList = ETokenList::Actors;
+		}
+		else if (Token == TEXT("ASSETS"))
+		{
+			CurrentList = ETokenList::Assets;
+		}
+		else if (Token == TEXT("PARAM"))
+		{
+			CurrentList = ETokenList::Params;
+		}
+		else if (CurrentList == ETokenList::Actors)
+		{
+			ActorPaths.Add(Token);
+		}
+		else if (CurrentList == ETokenList::Assets)
+		{
+			AssetPaths.Add(Token);
+		}
+		else if (CurrentList == ETokenList::Params)
+		{
+			FString ParamName;
+			FString ParamValue;
+			if (!Token.Split(TEXT("="), &ParamName, &ParamValue))
+			{
+				return FString::Printf(TEXT("ERR %s MalformedParam:%s"), *CommandName, *Token);
+			}
+			ParamValues.Add(FName(*ParamName), ParamValue);
+		}
+		else
+		{
+			return FString::Printf(TEXT("ERR %s UnexpectedToken:%s"), *CommandName, *Token);
+		}
+	}
+
+	bOutMalformed = false;
+
+	// Always passed, even when empty: missing parameters keep their defaults rather than opening a dialog from the ticker
+	const FName Command(*CommandName);
+	const TMap<FName, FString>* Params = &ParamValues;
+	int32 NumExecuted = 0;
+
+	// Script commands read whatever they need themselves, they can't be given targets or parameters
+	if (FCustomEditorHotkeysPythonScripts::IsInitialized() && FCustomEditorHotkeysPythonScripts::Get().FindEntryPoint(Command))
+	{
+		if (ActorPaths.Num() > 0 || AssetPaths.Num() > 0 || ParamValues.Num() > 0)
+		{
+			return FString::Printf(TEXT("ERR %s ScriptTakesNoArguments"), *CommandName);
+		}
+
+		if (!FCustomEditorHotkeysPythonScripts::RunScriptCommand(Command))
+		{
+			return FString::Printf(TEXT("ERR %s ScriptFailed"), *CommandName);
+		}
+
+		NumExecuted = 1;
+	}
+	else if (ActorPaths.Num() > 0)
+	{
+		TArray<AActor*> Actors;
+		TSet<FString> UnresolvedLabels;
+		for (const FString& ActorPath : ActorPaths)
+		{
+			if (AActor* Actor = FindObject<AActor>(nullptr, *ActorPath))
+			{
+				Actors.Add(Actor);
+			}
+			else
+			{
+				UnresolvedLabels.Add(ActorPath);
+			}
+		}
+
+		// Anything that isn't an object path is looked up by its label in a single pass over the editor world
+		if (UnresolvedLabels.Num() > 0 && GEditor)
+		{
+			for (TActorIterator<AActor> It(GEditor->GetEditorWorldContext().World()); It && UnresolvedLabels.Num() > 0; ++It)
+			{
+				if (UnresolvedLabels.Remove(It->GetActorLabel()) > 0)
+				{
+					Actors.Add(*It);
+				}
+			}
+		}
+
+		if (UnresolvedLabels.Num() > 0)
+		{
+			return FString::Printf(TEXT("ERR %s UnknownActor:%s"), *CommandName, *UnresolvedLabels.Array()[0]);
+		}
+
+		NumExecuted = FCustomEditorHotkeysBlutilityExtensions::ExecuteActorUtilityFunctionOnActors(Command, Actors, Params);
+	}
+	else if (AssetPaths.Num() > 0)
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+		TArray<FAssetData> Assets;
+		for (const FString& AssetPath : AssetPaths)
+		{
+			FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(AssetPath));
+			if (!AssetData.IsValid())
+			{
+				return FString::Printf(TEXT("ERR %s UnknownAsset:%s"), *CommandName, *AssetPath);
+			}
+			Assets.Add(MoveTemp(AssetData));
+		}
+
+		NumExecuted = FCustomEditorHotkeysBlutilityExtensions::ExecuteAssetUtilityFunctionOnAssets(Command, Assets, Params);
+	}
+	else
+	{
+		TSharedPtr<const FCustomEditorHotkeysDispatchTable> LevelEditorDispatchTable = FCustomEditorHotkeysCommands::GetLevelEditorDispatchTable();
+		if (LevelEditorDispatchTable.IsValid() && LevelEditorDispatchTable->Contains(Command))
+		{
+			NumExecuted = FCustomEditorHotkeysBlutilityExtensions::ExecuteActorUtilityFunctionOnSelection(Command, Params);
+		}
+		else
+		{
+			NumExecuted = FCustomEditorHotkeysBlutilityExtensions::ExecuteAssetUtilityFunctionOnSelection(Command, Params);
+		}
+	}
+
+	if (NumExecuted == 0)
+	{
+		return FString::Printf(TEXT("ERR %s NoSupportedOverload"), *CommandName);
+	}
+
+	const double EndTime = FPlatformTime::Seconds();
+	return FString::Printf(TEXT("OK %s %d %.3f %.3f"), *CommandName, NumExecuted, (EndTime - StartTime) * 1000.0, (StartTime - Request.ReceivedTime) * 1000.0);
+}
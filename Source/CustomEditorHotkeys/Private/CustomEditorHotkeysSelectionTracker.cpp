@@ -0,0 +1,240 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CustomEditorHotkeysSelectionTracker.h"
+#include "CustomEditorHotkeys.h"
+#include "ContentBrowserModule.h"
+#include "IContentBrowserSingleton.h"
+#include "Editor.h"
+#include "Selection.h"
+#include "Engine/Blueprint.h"
+#include "GameFramework/Actor.h"
+
+TSharedPtr<FCustomEditorHotkeysSelectionTracker> FCustomEditorHotkeysSelectionTracker::Instance = nullptr;
+
+void FCustomEditorHotkeysSelectionTracker::Initialize()
+{
+	if (!Instance.IsValid())
+	{
+		Instance = MakeShareable(new FCustomEditorHotkeysSelectionTracker());
+	}
+}
+
+void FCustomEditorHotkeysSelectionTracker::Shutdown()
+{
+	ensure(!Instance.IsValid() || Instance.IsUnique());
+	Instance.Reset();
+}
+
+const FCustomEditorHotkeysSelectionTracker& FCustomEditorHotkeysSelectionTracker::Get()
+{
+	return *Instance;
+}
+
+FCustomEditorHotkeysSelectionTracker::FCustomEditorHotkeysSelectionTracker()
+{
+	SelectObjectDelegateHandle = USelection::SelectObjectEvent.AddRaw(this, &FCustomEditorHotkeysSelectionTracker::OnObjectSelected);
+	SelectionChangedDelegateHandle = USelection::SelectionChangedEvent.AddRaw(this, &FCustomEditorHotkeysSelectionTracker::OnSelectionChanged);
+	SelectNoneDelegateHandle = USelection::SelectNoneEvent.AddRaw(this, &FCustomEditorHotkeysSelectionTracker::OnSelectNone);
+
+	FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"));
+	AssetSelectionChangedDelegateHandle = ContentBrowserModule.GetOnAssetSelectionChanged().AddRaw(this, &FCustomEditorHotkeysSelectionTracker::OnAssetSelectionChanged);
+}
+
+FCustomEditorHotkeysSelectionTracker::~FCustomEditorHotkeysSelectionTracker()
+{
+	USelection::SelectObjectEvent.Remove(SelectObjectDelegateHandle);
+	USelection::SelectionChangedEvent.Remove(SelectionChangedDelegateHandle);
+	USelection::SelectNoneEvent.Remove(SelectNoneDelegateHandle);
+
+	if (FContentBrowserModule* ContentBrowserModule = FModuleManager::GetModulePtr<FContentBrowserModule>(TEXT("ContentBrowser")))
+	{
+		ContentBrowserModule->GetOnAssetSelectionChanged().Remove(AssetSelectionChangedDelegateHandle);
+	}
+}
+
+const TMap<TObjectKey<UClass>, FCustomEditorHotkeysSelectionTracker::FActorBucket>& FCustomEditorHotkeysSelectionTracker::GetSelectedActors() const
+{
+	if (bActorsDirty)
+	{
+		SynchronizeActors();
+	}
+
+	return ActorBuckets;
+}
+
+const TMap<TObjectKey<UClass>, FCustomEditorHotkeysSelectionTracker::FAssetBucket>& FCustomEditorHotkeysSelectionTracker::GetSelectedAssets() const
+{
+	if (bAssetsDirty)
+	{
+		SynchronizeAssets();
+	}
+
+	return AssetBuckets;
+}
+
+void FCustomEditorHotkeysSelectionTracker::GetSelectedActorClasses(TArray<const UClass*>& OutClasses) const
+{
+	for (const TPair<TObjectKey<UClass>, FActorBucket>& Pair : GetSelectedActors())
+	{
+		const UClass* Class = Pair.Value.Class.Get();
+		if (Class && Pair.Value.Objects.ContainsByPredicate([](const TWeakObjectPtr<AActor>& Actor) { return Actor.IsValid(); }))
+		{
+			OutClasses.Add(Class);
+		}
+	}
+}
+
+void FCustomEditorHotkeysSelectionTracker::GetSelectedAssetClasses(TArray<const UClass*>& OutClasses) const
+{
+	for (const TPair<TObjectKey<UClass>, FAssetBucket>& Pair : GetSelectedAssets())
+	{
+		if (const UClass* Class = Pair.Value.Class.Get())
+		{
+			OutClasses.Add(Class);
+		}
+	}
+}
+
+UClass* FCustomEditorHotkeysSelectionTracker::GetDispatchClass(const FAssetData& AssetData)
+{
+	UClass* AssetClass = AssetData.GetClass();
+	if (AssetClass && AssetClass->IsChildOf<UBlueprint>())
+	{
+		// Prefer the generated class when the blueprint is loaded, otherwise fall back on its parent so we don't load anything here
+		for (const FName& TagName : { FBlueprintTags::GeneratedClassPath, FBlueprintTags::ParentClassPath })
+		{
+			FAssetDataTagMapSharedView::FFindTagResult Result = AssetData.TagsAndValues.FindTag(TagName);
+			if (Result.IsSet())
+			{
+				const FString ClassObjectPath = FPackageName::ExportTextPathToObjectPath(Result.GetValue());
+				if (UClass* Class = FindObject<UClass>(nullptr, *ClassObjectPath))
+				{
+					return Class;
+				}
+			}
+		}
+	}
+
+	return AssetClass;
+}
+
+void FCustomEditorHotkeysSelectionTracker::OnObjectSelected(UObject* Object)
+{
+	AActor* Actor = Cast<AActor>(Object);
+	if (!Actor || !GEditor)
+	{
+		return;
+	}
+
+	bActorEventsSinceChange = true;
+	if (bActorsDirty)
+	{
+		return;
+	}
+
+	if (GEditor->GetSelectedActors()->IsSelected(Actor))
+	{
+		AddActor(Actor);
+	}
+	else
+	{
+		RemoveActor(Actor);
+	}
+}
+
+void FCustomEditorHotkeysSelectionTracker::OnSelectionChanged(UObject* Selection)
+{
+	// Edits that selected or deselected actors one by one were already followed in OnObjectSelected. A change without any
+	// of those (e.g. undo restoring the selection) doesn't say what changed, so only then are the buckets marked dirty,
+	// to be rebuilt the next time a command reads them.
+	if (GEditor && Selection == GEditor->GetSelectedActors())
+	{
+		if (!bActorEventsSinceChange)
+		{
+			bActorsDirty = true;
+		}
+		bActorEventsSinceChange = false;
+	}
+}
+
+void FCustomEditorHotkeysSelectionTracker::OnSelectNone()
+{
+	ActorBuckets.Reset();
+	bActorsDirty = false;
+	bActorEventsSinceChange = true;
+}
+
+void FCustomEditorHotkeysSelectionTracker::OnAssetSelectionChanged(const TArray<FAssetData>& NewSelectedAssets, bool bIsPrimaryBrowser)
+{
+	// Asset utilities read the primary browser's selection, so that's the only one we mirror
+	if (bIsPrimaryBrowser)
+	{
+		SetSelectedAssets(NewSelectedAssets);
+	}
+}
+
+void FCustomEditorHotkeysSelectionTracker::AddActor(AActor* Actor) const
+{
+	FActorBucket& Bucket = ActorBuckets.FindOrAdd(Actor->GetClass());
+	Bucket.Class = Actor->GetClass();
+
+	Bucket.Objects.AddUnique(Actor);
+}
+
+void FCustomEditorHotkeysSelectionTracker::RemoveActor(AActor* Actor) const
+{
+	if (FActorBucket* Bucket = ActorBuckets.Find(Actor->GetClass()))
+	{
+		Bucket->Objects.RemoveSwap(Actor);
+
+		if (Bucket->Objects.Num() == 0)
+		{
+			ActorBuckets.Remove(Actor->GetClass());
+		}
+	}
+}
+
+void FCustomEditorHotkeysSelectionTracker::SetSelectedAssets(const TArray<FAssetData>& SelectedAssets) const
+{
+	AssetBuckets.Reset();
+
+	for (const FAssetData& AssetData : SelectedAssets)
+	{
+		if (UClass* DispatchClass = GetDispatchClass(AssetData))
+		{
+			FAssetBucket& Bucket = AssetBuckets.FindOrAdd(DispatchClass);
+			Bucket.Class = DispatchClass;
+			Bucket.Objects.Add(AssetData);
+		}
+	}
+
+	bAssetsDirty = false;
+}
+
+void FCustomEditorHotkeysSelectionTracker::SynchronizeActors() const
+{
+	ActorBuckets.Reset();
+
+	if (GEditor)
+	{
+		for (FSelectionIterator It(GEditor->GetSelectedActorIterator()); It; ++It)
+		{
+			if (AActor* Actor = Cast<AActor>(*It))
+			{
+				AddActor(Actor);
+			}
+		}
+	}
+
+	bActorsDirty = false;
+}
+
+void FCustomEditorHotkeysSelectionTracker::SynchronizeAssets() const
+{
+	TArray<FAssetData> SelectedAssets;
+
+	FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"));
+	ContentBrowserModule.Get().GetSelectedAssets(SelectedAssets);
+
+	SetSelectedAssets(SelectedAssets);
+}
@@ -0,0 +1,11 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CustomEditorHotkeysSettings.h"
+
+UCustomEditorHotkeysSettings::UCustomEditorHotkeysSettings()
+	: bUseParameterPanel(false)
+	, bEnableRemoteTrigger(false)
+	, RemoteTriggerPort(30110)
+	, MaxRemoteRequestsPerTick(64)
+{
+}
@@ -0,0 +1,275 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CustomEditorHotkeysSoakTestCommandlet.h"
+#include "CustomEditorHotkeys.h"
+#include "CustomEditorHotkeysCommands.h"
+#include "CustomEditorHotkeysDispatch.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Editor.h"
+#include "EditorUtilityBlueprint.h"
+#include "EngineUtils.h"
+#include "FileHelpers.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "UObject/UObjectIterator.h"
+
+#define LOCTEXT_NAMESPACE "FCustomEditorHotkeysModule"
+
+namespace CustomEditorHotkeysSoakTest
+{
+	struct FSample
+	{
+		int32 NumObjects = 0;
+		int32 NumRooted = 0;
+		uint64 UsedPhysical = 0;
+		uint64 PeakUsedPhysical = 0;
+	};
+
+	static FSample TakeSample()
+	{
+		// Every transaction keeps the objects it touched alive, drop the undo history so only real leaks remain
+		if (GEditor)
+		{
+			GEditor->ResetTransaction(LOCTEXT("SoakTestResetTransaction", "Hotkey soak test sample"));
+		}
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		FSample Sample;
+		Sample.NumObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+		for (FRawObjectIterator It; It; ++It)
+		{
+			if ((*It)->IsRootSet())
+			{
+				++Sample.NumRooted;
+			}
+		}
+
+		const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+		Sample.UsedPhysical = MemoryStats.UsedPhysical;
+		Sample.PeakUsedPhysical = MemoryStats.PeakUsedPhysical;
+		return Sample;
+	}
+
+	static double Average(TArrayView<const double> Values)
+	{
+		double Total = 0.0;
+		for (double Value : Values)
+		{
+			Total += Value;
+		}
+		return Values.Num() > 0 ? Total / Values.Num() : 0.0;
+	}
+}
+
+UCustomEditorHotkeysSoakTestCommandlet::UCustomEditorHotkeysSoakTestCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UCustomEditorHotkeysSoakTestCommandlet::Main(const FString& Params)
+{
+	using namespace CustomEditorHotkeysSoakTest;
+
+	int32 Iterations = 5000;
+	int32 Seed = 0;
+	int32 SampleEvery = 250;
+	int32 MaxObjectGrowth = 1000;
+	int32 MaxRootedGrowth = 0;
+	int32 MaxMemoryGrowthMB = 256;
+	int32 MaxPeakGrowthMB = 512;
+	float MaxLatencyDrift = 0.5f;
+	FString MapName;
+
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("SampleEvery="), SampleEvery);
+	FParse::Value(*Params, TEXT("MaxObjectGrowth="), MaxObjectGrowth);
+	FParse::Value(*Params, TEXT("MaxRootedGrowth="), MaxRootedGrowth);
+	FParse::Value(*Params, TEXT("MaxMemoryGrowthMB="), MaxMemoryGrowthMB);
+	FParse::Value(*Params, TEXT("MaxPeakGrowthMB="), MaxPeakGrowthMB);
+	FParse::Value(*Params, TEXT("MaxLatencyDrift="), MaxLatencyDrift);
+	FParse::Value(*Params, TEXT("Map="), MapName);
+
+	Iterations = FMath::Max(Iterations, 1);
+	SampleEvery = FMath::Max(SampleEvery, 1);
+
+	if (!GEditor)
+	{
+		UE_LOG(LogCustomEditorHotkeys, Error, TEXT("The soak test needs to run in the editor executable."));
+		return 1;
+	}
+
+	if (!MapName.IsEmpty() && !UEditorLoadingAndSavingUtils::LoadMap(MapName))
+	{
+		UE_LOG(LogCustomEditorHotkeys, Error, TEXT("Could not load map \"%s\"."), *MapName);
+		return 1;
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FCustomEditorHotkeysModule& Module = FModuleManager::LoadModuleChecked<FCustomEditorHotkeysModule>(TEXT("CustomEditorHotkeys"));
+	Module.PluginButtonClicked();
+
+	TArray<FName> LevelEditorCommands;
+	FCustomEditorHotkeysCommands::GetCustomLevelEditorCommands().GetKeys(LevelEditorCommands);
+	TArray<FName> ContentBrowserCommands;
+	FCustomEditorHotkeysCommands::GetCustomContentBrowserCommands().GetKeys(ContentBrowserCommands);
+
+	TArray<FAssetData> UtilityBlueprints;
+	AssetRegistry.GetAssetsByClass(UEditorUtilityBlueprint::StaticClass()->GetFName(), UtilityBlueprints, true);
+
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	if (UWorld* World = GEditor->GetEditorWorldContext().World())
+	{
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			Actors.Add(*It);
+		}
+	}
+
+	if (LevelEditorCommands.Num() + ContentBrowserCommands.Num() == 0)
+	{
+		UE_LOG(LogCustomEditorHotkeys, Error, TEXT("No custom commands are registered, there is nothing to soak."));
+		return 1;
+	}
+
+	UE_LOG(LogCustomEditorHotkeys, Display, TEXT("Soaking %d level editor and %d content browser commands over %d iterations (seed %d, %d actors, %d utility blueprints)."),
+		LevelEditorCommands.Num(), ContentBrowserCommands.Num(), Iterations, Seed, Actors.Num(), UtilityBlueprints.Num());
+
+	// Parameters are always supplied so functions with parameters never open their dialog
+	const TMap<FName, FString> NoParamValues;
+
+	FRandomStream Random(Seed);
+	TArray<double> PressSeconds;
+	PressSeconds.Reserve(Iterations);
+
+	// The first samples include one-off costs such as loading utilities, growth is measured against the end of the warm up
+	const int32 WarmupIterations = FMath::Min(SampleEvery, Iterations / 10);
+	FSample Baseline = TakeSample();
+	int32 BaselinePress = 0;
+	uint64 PeakUsedPhysical = Baseline.PeakUsedPhysical;
+
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		const int32 Roll = Random.RandRange(0, 99);
+		if (Roll < 60)
+		{
+			const bool bContentBrowserCommand = ContentBrowserCommands.Num() > 0 && (LevelEditorCommands.Num() == 0 || Random.RandRange(0, 3) == 0);
+			const TArray<FName>& Commands = bContentBrowserCommand ? ContentBrowserCommands : LevelEditorCommands;
+			const FName CommandName = Commands[Random.RandRange(0, Commands.Num() - 1)];
+
+			const double StartTime = FPlatformTime::Seconds();
+			if (bContentBrowserCommand)
+			{
+				FCustomEditorHotkeysBlutilityExtensions::ExecuteAssetUtilityFunctionOnSelection(CommandName, &NoParamValues);
+			}
+			else
+			{
+				FCustomEditorHotkeysBlutilityExtensions::ExecuteActorUtilityFunctionOnSelection(CommandName, &NoParamValues);
+			}
+			PressSeconds.Add(FPlatformTime::Seconds() - StartTime);
+		}
+		else if (Roll < 85)
+		{
+			GEditor->SelectNone(false, true);
+			const int32 NumToSelect = Actors.Num() > 0 ? Random.RandRange(0, FMath::Min(Actors.Num(), 8)) : 0;
+			for (int32 Index = 0; Index < NumToSelect; ++Index)
+			{
+				if (AActor* Actor = Actors[Random.RandRange(0, Actors.Num() - 1)].Get())
+				{
+					GEditor->SelectActor(Actor, true, false);
+				}
+			}
+			GEditor->NoteSelectionChange();
+		}
+		else if (Roll < 95)
+		{
+			Module.PluginButtonClicked();
+		}
+		else if (UtilityBlueprints.Num() > 0)
+		{
+			if (UBlueprint* Blueprint = Cast<UBlueprint>(UtilityBlueprints[Random.RandRange(0, UtilityBlueprints.Num() - 1)].GetAsset()))
+			{
+				FKismetEditorUtilities::CompileBlueprint(Blueprint);
+			}
+		}
+
+		// Deferred work such as the refresh after a recompile runs from the core ticker
+		FTSTicker::GetCoreTicker().Tick(0.0f);
+
+		if (Iteration + 1 == WarmupIterations)
+		{
+			Baseline = TakeSample();
+			BaselinePress = PressSeconds.Num();
+		}
+		else if ((Iteration + 1) % SampleEvery == 0)
+		{
+			const FSample Sample = TakeSample();
+			PeakUsedPhysical = FMath::Max(PeakUsedPhysical, Sample.PeakUsedPhysical);
+			UE_LOG(LogCustomEditorHotkeys, Display, TEXT("[%d/%d] objects %d (%+d), rooted %d (%+d), used memory %.1f MB (%+.1f MB)"),
+				Iteration + 1, Iterations, Sample.NumObjects, Sample.NumObjects - Baseline.NumObjects, Sample.NumRooted, Sample.NumRooted - Baseline.NumRooted,
+				Sample.UsedPhysical / 1024.0 / 1024.0, (double(Sample.UsedPhysical) - double(Baseline.UsedPhysical)) / 1024.0 / 1024.0);
+		}
+	}
+
+	const FSample Final = TakeSample();
+	PeakUsedPhysical = FMath::Max(PeakUsedPhysical, Final.PeakUsedPhysical);
+
+	// Compare the first and last tenth of the presses made after the warm up
+	double LatencyDrift = 0.0;
+	double FirstWindowMs = 0.0;
+	double LastWindowMs = 0.0;
+	const TArrayView<const double> MeasuredPresses = MakeArrayView(PressSeconds).Slice(BaselinePress, PressSeconds.Num() - BaselinePress);
+	const int32 WindowSize = MeasuredPresses.Num() / 10;
+	if (WindowSize >= 10)
+	{
+		FirstWindowMs = Average(MeasuredPresses.Slice(0, WindowSize)) * 1000.0;
+		LastWindowMs = Average(MeasuredPresses.Slice(MeasuredPresses.Num() - WindowSize, WindowSize)) * 1000.0;
+		LatencyDrift = FirstWindowMs > 0.0 ? (LastWindowMs - FirstWindowMs) / FirstWindowMs : 0.0;
+	}
+
+	const int32 ObjectGrowth = Final.NumObjects - Baseline.NumObjects;
+	const int32 RootedGrowth = Final.NumRooted - Baseline.NumRooted;
+	const double MemoryGrowthMB = (double(Final.UsedPhysical) - double(Baseline.UsedPhysical)) / 1024.0 / 1024.0;
+	// A press that briefly allocates a lot is freed again before the next sample, only the peak catches it
+	const double PeakGrowthMB = (double(PeakUsedPhysical) - double(Baseline.PeakUsedPhysical)) / 1024.0 / 1024.0;
+
+	UE_LOG(LogCustomEditorHotkeys, Display, TEXT("Soak finished: %d presses, objects %+d, rooted %+d, used memory %+.1f MB (peak %.1f MB, %+.1f MB), press latency %.3f ms -> %.3f ms (%+.0f%%)"),
+		PressSeconds.Num(), ObjectGrowth, RootedGrowth, MemoryGrowthMB, PeakUsedPhysical / 1024.0 / 1024.0, PeakGrowthMB, FirstWindowMs, LastWindowMs, LatencyDrift * 100.0);
+
+	bool bPassed = true;
+	if (ObjectGrowth > MaxObjectGrowth)
+	{
+		UE_LOG(LogCustomEditorHotkeys, Error, TEXT("Object count grew by %d, more than the allowed %d."), ObjectGrowth, MaxObjectGrowth);
+		bPassed = false;
+	}
+	if (RootedGrowth > MaxRootedGrowth)
+	{
+		UE_LOG(LogCustomEditorHotkeys, Error, TEXT("Rooted object count grew by %d, more than the allowed %d."), RootedGrowth, MaxRootedGrowth);
+		bPassed = false;
+	}
+	if (MemoryGrowthMB > MaxMemoryGrowthMB)
+	{
+		UE_LOG(LogCustomEditorHotkeys, Error, TEXT("Used memory grew by %.1f MB, more than the allowed %d MB."), MemoryGrowthMB, MaxMemoryGrowthMB);
+		bPassed = false;
+	}
+	if (PeakGrowthMB > MaxPeakGrowthMB)
+	{
+		UE_LOG(LogCustomEditorHotkeys, Error, TEXT("Peak used memory grew by %.1f MB, more than the allowed %d MB."), PeakGrowthMB, MaxPeakGrowthMB);
+		bPassed = false;
+	}
+	if (LatencyDrift > MaxLatencyDrift)
+	{
+		UE_LOG(LogCustomEditorHotkeys, Error, TEXT("Press latency drifted by %.0f%%, more than the allowed %.0f%%."), LatencyDrift * 100.0, MaxLatencyDrift * 100.0);
+		bPassed = false;
+	}
+
+	return bPassed ? 0 : 1;
+}
+
+#undef LOCTEXT_NAMESPACE
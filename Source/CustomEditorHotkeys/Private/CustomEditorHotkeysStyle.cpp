@@ -7,9 +7,87 @@
 #include "Slate/SlateGameResources.h"
 #include "Interfaces/IPluginManager.h"
 #include "Styling/SlateStyleMacros.h"
+#include "Brushes/SlateImageBrush.h"
+#include "Misc/Paths.h"
 
 #define RootToContentDir Style->RootToContentDir
 
+const FVector2D Icon16x16(16.0f, 16.0f);
+const FVector2D Icon20x20(20.0f, 20.0f);
+
+/**
+ * Style set that resolves custom command icons on demand. Commands only declare an image path, the brush is created the
+ * first time the icon is looked up and shared by every command using the same image. Image brushes aren't dynamic, so
+ * the renderer packs them into its shared texture atlas.
+ */
+class FCustomEditorHotkeysStyleSet : public FSlateStyleSet
+{
+public:
+	FCustomEditorHotkeysStyleSet(const FName& InStyleSetName)
+		: FSlateStyleSet(InStyleSetName)
+	{
+	}
+
+	void SetCommandIcon(FName IconKey, const FString& ImagePath)
+	{
+		CommandIconPaths.Add(IconKey, ImagePath);
+	}
+
+	void ClearCommandIcons()
+	{
+		CommandIconPaths.Reset();
+	}
+
+	virtual const FSlateBrush* GetBrush(const FName PropertyName, const ANSICHAR* Specifier = nullptr, const ISlateStyle* RequestingStyle = nullptr) const override
+	{
+		if (const FSlateBrush* CommandIcon = FindCommandIcon(Specifier ? Join(PropertyName, Specifier) : PropertyName))
+		{
+			return CommandIcon;
+		}
+
+		return FSlateStyleSet::GetBrush(PropertyName, Specifier, RequestingStyle);
+	}
+
+	virtual const FSlateBrush* GetOptionalBrush(const FName PropertyName, const ANSICHAR* Specifier = nullptr, const FSlateBrush* const DefaultBrush = FStyleDefaults::GetNoBrush()) const override
+	{
+		if (const FSlateBrush* CommandIcon = FindCommandIcon(Specifier ? Join(PropertyName, Specifier) : PropertyName))
+		{
+			return CommandIcon;
+		}
+
+		return FSlateStyleSet::GetOptionalBrush(PropertyName, Specifier, DefaultBrush);
+	}
+
+private:
+	const FSlateBrush* FindCommandIcon(FName IconKey) const
+	{
+		const FString* ImagePath = CommandIconPaths.Find(IconKey);
+		if (!ImagePath)
+		{
+			return nullptr;
+		}
+
+		if (const TUniquePtr<FSlateBrush>* CachedBrush = CommandIconBrushes.Find(*ImagePath))
+		{
+			return CachedBrush->Get();
+		}
+
+		FSlateBrush* Brush = FPaths::GetExtension(*ImagePath) == TEXT("svg")
+			? static_cast<FSlateBrush*>(new FSlateVectorImageBrush(*ImagePath, Icon20x20))
+			: static_cast<FSlateBrush*>(new FSlateImageBrush(*ImagePath, Icon20x20));
+
+		CommandIconBrushes.Add(*ImagePath, TUniquePtr<FSlateBrush>(Brush));
+		return Brush;
+	}
+
+private:
+	/** Declared command icons, icon key -> image path */
+	TMap<FName, FString> CommandIconPaths;
+
+	/** Brushes created so far, keyed by image path. Never pruned while the style is alive since widgets keep pointers to them. */
+	mutable TMap<FString, TUniquePtr<FSlateBrush>> CommandIconBrushes;
+};
+
 TSharedPtr<FSlateStyleSet> FCustomEditorHotkeysStyle::StyleInstance = nullptr;
 
 void FCustomEditorHotkeysStyle::Initialize()
@@ -34,24 +112,28 @@ FName FCustomEditorHotkeysStyle::GetStyleSetName()
 	return StyleSetName;
 }
 
-
-const FVector2D Icon16x16(16.0f, 16.0f);
-const FVector2D Icon20x20(20.0f, 20.0f);
-
 TSharedRef< FSlateStyleSet > FCustomEditorHotkeysStyle::Create()
 {
-	TSharedRef< FSlateStyleSet > Style = MakeShareable(new FSlateStyleSet("CustomEditorHotkeysStyle"));
+	TSharedRef< FSlateStyleSet > Style = MakeShareable(new FCustomEditorHotkeysStyleSet("CustomEditorHotkeysStyle"));
 	Style->SetContentRoot(IPluginManager::Get().FindPlugin("CustomEditorHotkeys")->GetBaseDir() / TEXT("Resources"));
 
 	Style->Set("CustomEditorHotkeys.PluginAction", new IMAGE_BRUSH_SVG(TEXT("HotkeysRefresh"), Icon20x20));
 	return Style;
 }
 
-void FCustomEditorHotkeysStyle::ReloadTextures()
+void FCustomEditorHotkeysStyle::SetCommandIcon(FName IconKey, const FString& ImagePath)
+{
+	if (StyleInstance.IsValid())
+	{
+		StaticCastSharedPtr<FCustomEditorHotkeysStyleSet>(StyleInstance)->SetCommandIcon(IconKey, ImagePath);
+	}
+}
+
+void FCustomEditorHotkeysStyle::ClearCommandIcons()
 {
-	if (FSlateApplication::IsInitialized())
+	if (StyleInstance.IsValid())
 	{
-		FSlateApplication::Get().GetRenderer()->ReloadTextureResources();
+		StaticCastSharedPtr<FCustomEditorHotkeysStyleSet>(StyleInstance)->ClearCommandIcons();
 	}
 }
 
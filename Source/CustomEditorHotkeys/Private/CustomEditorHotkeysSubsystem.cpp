@@ -0,0 +1,233 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CustomEditorHotkeysSubsystem.h"
+#include "CustomEditorHotkeys.h"
+#include "CustomEditorHotkeysCommands.h"
+#include "CustomEditorHotkeysDispatch.h"
+#include "CustomEditorHotkeysPythonScripts.h"
+#include "CustomEditorHotkeysSelectionTracker.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Editor.h"
+#include "ScopedTransaction.h"
+
+#define LOCTEXT_NAMESPACE "FCustomEditorHotkeysModule"
+
+FCustomEditorHotkeysBatchResult UCustomEditorHotkeysSubsystem::RunCommandsOnActors(const TArray<FName>& CommandNames, const TArray<AActor*>& Actors, const TMap<FName, FString>& ParamValues, bool bSingleTransaction /*= true*/)
+{
+	TArray<FTarget> Targets;
+	Targets.Reserve(Actors.Num());
+
+	for (AActor* Actor : Actors)
+	{
+		FTarget& Target = Targets.AddDefaulted_GetRef();
+		Target.Path = FSoftObjectPath(Actor);
+		Target.DispatchClass = Actor ? Actor->GetClass() : nullptr;
+		Target.ObjectClass = Target.DispatchClass;
+		Target.Object = Actor;
+	}
+
+	return RunCommands(CommandNames, Targets, false, ParamValues, bSingleTransaction);
+}
+
+FCustomEditorHotkeysBatchResult UCustomEditorHotkeysSubsystem::RunCommandsOnAssets(const TArray<FName>& CommandNames, const TArray<FAssetData>& Assets, const TMap<FName, FString>& ParamValues, bool bSingleTransaction /*= true*/)
+{
+	TArray<FTarget> Targets;
+	Targets.Reserve(Assets.Num());
+
+	for (const FAssetData& Asset : Assets)
+	{
+		FTarget& Target = Targets.AddDefaulted_GetRef();
+		Target.Path = Asset.ToSoftObjectPath();
+		Target.DispatchClass = Asset.IsValid() ? FCustomEditorHotkeysSelectionTracker::GetDispatchClass(Asset) : nullptr;
+		Target.ObjectClass = Asset.IsValid() ? Asset.GetClass() : nullptr;
+		Target.AssetData = Asset;
+	}
+
+	return RunCommands(CommandNames, Targets, true, ParamValues, bSingleTransaction);
+}
+
+FCustomEditorHotkeysBatchResult UCustomEditorHotkeysSubsystem::RunCommandsOnAssetPaths(const TArray<FName>& CommandNames, const TArray<FString>& AssetPaths, const TMap<FName, FString>& ParamValues, bool bSingleTransaction /*= true*/)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FAssetData> Assets;
+	Assets.Reserve(AssetPaths.Num());
+
+	for (const FString& AssetPath : AssetPaths)
+	{
+		Assets.Add(AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(AssetPath)));
+	}
+
+	FCustomEditorHotkeysBatchResult BatchResult = RunCommandsOnAssets(CommandNames, Assets, ParamValues, bSingleTransaction);
+
+	// Paths that didn't match an asset have no asset data to report the target from
+	for (int32 ResultIndex = 0; ResultIndex < BatchResult.Results.Num(); ++ResultIndex)
+	{
+		BatchResult.Results[ResultIndex].Target = FSoftObjectPath(AssetPaths[ResultIndex % AssetPaths.Num()]);
+	}
+
+	return BatchResult;
+}
+
+FCustomEditorHotkeysBatchResult UCustomEditorHotkeysSubsystem::RunCommands(const TArray<FName>& CommandNames, TArray<FTarget>& Targets, bool bContentBrowserCommands, const TMap<FName, FString>& ParamValues, bool bSingleTransaction)
+{
+	using FFunctionAndUtil = FCustomEditorHotkeysBlutilityExtensions::FFunctionAndUtil;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FCustomEditorHotkeysBatchResult BatchResult;
+	BatchResult.Results.SetNum(CommandNames.Num() * Targets.Num());
+
+	TSharedPtr<const FCustomEditorHotkeysDispatchTable> DispatchTable = bContentBrowserCommands
+		? FCustomEditorHotkeysCommands::GetContentBrowserDispatchTable()
+		: FCustomEditorHotkeysCommands::GetLevelEditorDispatchTable();
+
+	TOptional<FScopedTransaction> Transaction;
+	if (bSingleTransaction && Targets.Num() > 0)
+	{
+		Transaction.Emplace(LOCTEXT("RunCommandsTransaction", "Run Custom Commands"));
+	}
+
+	for (int32 CommandIndex = 0; CommandIndex < CommandNames.Num(); ++CommandIndex)
+	{
+		const FName CommandName = CommandNames[CommandIndex];
+		TArrayView<FCustomEditorHotkeysTargetResult> CommandResults = MakeArrayView(BatchResult.Results).Slice(CommandIndex * Targets.Num(), Targets.Num());
+
+		for (int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex)
+		{
+			CommandResults[TargetIndex].CommandName = CommandName;
+			CommandResults[TargetIndex].Target = Targets[TargetIndex].Path;
+		}
+
+		if (!DispatchTable.IsValid() || !DispatchTable->Contains(CommandName))
+		{
+			const bool bScriptCommand = FCustomEditorHotkeysPythonScripts::IsInitialized() && FCustomEditorHotkeysPythonScripts::Get().FindEntryPoint(CommandName);
+			for (FCustomEditorHotkeysTargetResult& Result : CommandResults)
+			{
+				Result.Error = bScriptCommand
+					? FString::Printf(TEXT("\"%s\" is a Python script command, scripts take no targets"), *CommandName.ToString())
+					: FString::Printf(TEXT("\"%s\" is not a %s custom command"), *CommandName.ToString(), bContentBrowserCommands ? TEXT("content browser") : TEXT("level editor"));
+			}
+			continue;
+		}
+
+		// Targets resolving to the same overload are handed to it together
+		TArray<TPair<FFunctionAndUtil, TArray<int32>>, TInlineAllocator<4>> Groups;
+		for (int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex)
+		{
+			const FTarget& Target = Targets[TargetIndex];
+			const FFunctionAndUtil* FunctionAndUtil = Target.DispatchClass ? DispatchTable->Resolve(CommandName, Target.DispatchClass) : nullptr;
+			if (!FunctionAndUtil)
+			{
+				CommandResults[TargetIndex].Error = Target.DispatchClass
+					? FString::Printf(TEXT("No overload of \"%s\" supports %s"), *CommandName.ToString(), *Target.DispatchClass->GetName())
+					: FString(TEXT("Target not found"));
+				continue;
+			}
+
+			TPair<FFunctionAndUtil, TArray<int32>>* Group = Groups.FindByPredicate([FunctionAndUtil](const TPair<FFunctionAndUtil, TArray<int32>>& Candidate) { return Candidate.Key == *FunctionAndUtil; });
+			if (!Group)
+			{
+				Group = &Groups.Emplace_GetRef(*FunctionAndUtil, TArray<int32>());
+			}
+			Group->Value.Add(TargetIndex);
+		}
+
+		for (const TPair<FFunctionAndUtil, TArray<int32>>& Group : Groups)
+		{
+			const TArray<int32>& TargetIndices = Group.Value;
+
+			// The parameter is found from the target classes, assets are only loaded once one can actually take them
+			TArray<const UClass*> ObjectClasses;
+			for (int32 TargetIndex : TargetIndices)
+			{
+				ObjectClasses.Add(Targets[TargetIndex].ObjectClass);
+			}
+
+			const FProperty* TargetParam = FCustomEditorHotkeysBlutilityExtensions::FindTargetParam(Group.Key.Function, ObjectClasses);
+			if (!TargetParam)
+			{
+				for (int32 TargetIndex : TargetIndices)
+				{
+					CommandResults[TargetIndex].Error = FString::Printf(TEXT("\"%s\" can only read the selection, give it a \"%s\" object or object array parameter, or %s metadata naming one, to run it on explicit targets"),
+						*CommandName.ToString(), *FCustomEditorHotkeysBlutilityExtensions::NAME_DefaultTargetParam.ToString(), *FCustomEditorHotkeysBlutilityExtensions::NAME_HotkeyTargets.ToString());
+				}
+				continue;
+			}
+
+			if (!FCustomEditorHotkeysBlutilityExtensions::IsTargetParamFree(Group.Key.Function, TargetParam, &ParamValues))
+			{
+				for (int32 TargetIndex : TargetIndices)
+				{
+					CommandResults[TargetIndex].Error = FString::Printf(TEXT("ParamValues also sets the target parameter \"%s\""), *TargetParam->GetName());
+				}
+				continue;
+			}
+
+			const bool bArrayParam = TargetParam->IsA<FArrayProperty>();
+
+			TArray<UObject*> Objects;
+			for (int32 TargetIndex : TargetIndices)
+			{
+				FTarget& Target = Targets[TargetIndex];
+				if (!Target.Object && Target.AssetData.IsValid())
+				{
+					Target.Object = Target.AssetData.GetAsset();
+				}
+				Objects.Add(Target.Object);
+			}
+
+			auto RunGroup = [&](TArrayView<const int32> GroupTargetIndices, TArrayView<UObject* const> ParamObjects)
+			{
+				const double CallStartTime = FPlatformTime::Seconds();
+
+				const bool bExecuted = FCustomEditorHotkeysBlutilityExtensions::ExecuteUtilityFunction(Group.Key, &ParamValues, [TargetParam, ParamObjects](void* ParamMemory)
+					{
+						FCustomEditorHotkeysBlutilityExtensions::SetTargetParam(TargetParam, ParamMemory, ParamObjects);
+					});
+
+				const float Milliseconds = float((FPlatformTime::Seconds() - CallStartTime) * 1000.0 / GroupTargetIndices.Num());
+				for (int32 TargetIndex : GroupTargetIndices)
+				{
+					CommandResults[TargetIndex].bSucceeded = bExecuted;
+					CommandResults[TargetIndex].Milliseconds = Milliseconds;
+					if (!bExecuted)
+					{
+						CommandResults[TargetIndex].Error = TEXT("The utility function did not run");
+					}
+				}
+			};
+
+			if (bArrayParam)
+			{
+				RunGroup(TargetIndices, Objects);
+			}
+			else
+			{
+				// A single object parameter takes one target per call
+				for (int32 Index = 0; Index < TargetIndices.Num(); ++Index)
+				{
+					RunGroup(MakeArrayView(&TargetIndices[Index], 1), MakeArrayView(&Objects[Index], 1));
+				}
+			}
+		}
+	}
+
+	for (const FCustomEditorHotkeysTargetResult& Result : BatchResult.Results)
+	{
+		if (Result.bSucceeded)
+		{
+			++BatchResult.NumSucceeded;
+		}
+		else
+		{
+			++BatchResult.NumFailed;
+		}
+	}
+	BatchResult.TotalMilliseconds = float((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	return BatchResult;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,242 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CustomEditorHotkeysWorldPartitionRunner.h"
+#include "CustomEditorHotkeys.h"
+#include "CustomEditorHotkeysCommands.h"
+#include "CustomEditorHotkeysDispatch.h"
+
+#include "Editor.h"
+#include "FileHelpers.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopedSlowTask.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionActorDesc.h"
+#include "WorldPartition/WorldPartitionHandle.h"
+
+#define LOCTEXT_NAMESPACE "FCustomEditorHotkeysModule"
+
+static bool ParseVectorArg(const FString& Value, FVector& OutVector)
+{
+	TArray<FString> Components;
+	if (Value.ParseIntoArray(Components, TEXT(",")) != 3)
+	{
+		return false;
+	}
+
+	OutVector = FVector(FCString::Atod(*Components[0]), FCString::Atod(*Components[1]), FCString::Atod(*Components[2]));
+	return true;
+}
+
+static FAutoConsoleCommand WorldPartitionRunCommand(
+	TEXT("CustomEditorHotkeys.WorldPartition.Run"),
+	TEXT("Runs an actor custom command over the current World Partition map in streamed batches, the actors are passed through the command's target parameter. The batches can't be undone. ")
+	TEXT("Usage: CustomEditorHotkeys.WorldPartition.Run <Command> [Class=<ClassPath>] [Min=X,Y,Z Max=X,Y,Z] [Batch=<Size>] [GCEvery=<Batches>] [<Param>=<Value>...]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (Args.Num() == 0 || !GEditor)
+			{
+				UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("CustomEditorHotkeys.WorldPartition.Run needs a command name."));
+				return;
+			}
+
+			FCustomEditorHotkeysWorldPartitionRunner::FSettings Settings;
+			Settings.CommandName = FName(*Args[0]);
+
+			FVector RegionMin;
+			FVector RegionMax;
+			bool bHasMin = false;
+			bool bHasMax = false;
+
+			for (int32 ArgIndex = 1; ArgIndex < Args.Num(); ++ArgIndex)
+			{
+				FString Key;
+				FString Value;
+				if (!Args[ArgIndex].Split(TEXT("="), &Key, &Value))
+				{
+					// Batches are unloaded as soon as they are done, without saving every change would be thrown away
+					UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Unknown argument \"%s\", batches are always saved before they are unloaded."), *Args[ArgIndex]);
+					return;
+				}
+
+				if (Key == TEXT("Class"))
+				{
+					Settings.ClassFilter = LoadObject<UClass>(nullptr, *Value);
+					if (!Settings.ClassFilter)
+					{
+						UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Unknown class \"%s\"."), *Value);
+						return;
+					}
+				}
+				else if (Key == TEXT("Min"))
+				{
+					bHasMin = ParseVectorArg(Value, RegionMin);
+				}
+				else if (Key == TEXT("Max"))
+				{
+					bHasMax = ParseVectorArg(Value, RegionMax);
+				}
+				else if (Key == TEXT("Batch"))
+				{
+					Settings.BatchSize = FCString::Atoi(*Value);
+				}
+				else if (Key == TEXT("GCEvery"))
+				{
+					Settings.BatchesPerGarbageCollection = FCString::Atoi(*Value);
+				}
+				else
+				{
+					Settings.ParamValues.Add(FName(*Key), Value);
+				}
+			}
+
+			if (bHasMin && bHasMax)
+			{
+				Settings.Region = FBox(RegionMin, RegionMax);
+			}
+
+			const FCustomEditorHotkeysWorldPartitionRunner::FResult Result = FCustomEditorHotkeysWorldPartitionRunner::Run(GEditor->GetEditorWorldContext().World(), Settings);
+			UE_LOG(LogCustomEditorHotkeys, Display, TEXT("%s: processed %d of %d matching actors in %d batches, %d skipped without a target parameter%s."),
+				*Settings.CommandName.ToString(), Result.NumProcessed, Result.NumMatched, Result.NumBatches, Result.NumUnsupported, Result.bCancelled ? TEXT(" (cancelled)") : TEXT(""));
+		}));
+
+FCustomEditorHotkeysWorldPartitionRunner::FResult FCustomEditorHotkeysWorldPartitionRunner::Run(UWorld* World, const FSettings& Settings)
+{
+	FResult Result;
+
+	UWorldPartition* WorldPartition = World ? World->GetWorldPartition() : nullptr;
+	TSharedPtr<const FCustomEditorHotkeysDispatchTable> DispatchTable = FCustomEditorHotkeysCommands::GetLevelEditorDispatchTable();
+
+	if (!WorldPartition || !DispatchTable.IsValid() || !DispatchTable->Contains(Settings.CommandName))
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("Cannot run \"%s\": the world has no World Partition or the command isn't an actor custom command."), *Settings.CommandName.ToString());
+		return Result;
+	}
+
+	// Match descriptors against the dispatch table without loading anything. Blueprint actors resolve against their
+	// generated class when it happens to be loaded, otherwise against their native class.
+	TArray<FGuid> MatchingActors;
+	TSet<const UFunction*> UnsupportedFunctions;
+	for (UActorDescContainer::TIterator<> It(WorldPartition); It; ++It)
+	{
+		const FWorldPartitionActorDesc* ActorDesc = *It;
+
+		if (Settings.Region.IsSet() && !Settings.Region->Intersect(ActorDesc->GetBounds()))
+		{
+			continue;
+		}
+
+		const UClass* ActorClass = nullptr;
+		if (!ActorDesc->GetBaseClass().IsNone())
+		{
+			ActorClass = FindObject<UClass>(nullptr, *ActorDesc->GetBaseClass().ToString());
+		}
+		if (!ActorClass)
+		{
+			ActorClass = ActorDesc->GetActorClass();
+		}
+
+		if (!ActorClass || (Settings.ClassFilter && !ActorClass->IsChildOf(Settings.ClassFilter)))
+		{
+			continue;
+		}
+
+		const FCustomEditorHotkeysBlutilityExtensions::FFunctionAndUtil* FunctionAndUtil = DispatchTable->Resolve(Settings.CommandName, ActorClass);
+		if (!FunctionAndUtil)
+		{
+			continue;
+		}
+
+		// Actors are passed through the target parameter, overloads that only read the selection can't take them
+		if (!FCustomEditorHotkeysBlutilityExtensions::FindTargetParam(FunctionAndUtil->Function, MakeArrayView(&ActorClass, 1)))
+		{
+			++Result.NumUnsupported;
+			UnsupportedFunctions.Add(FunctionAndUtil->Function);
+			continue;
+		}
+
+		MatchingActors.Add(ActorDesc->GetGuid());
+	}
+
+	for (const UFunction* Function : UnsupportedFunctions)
+	{
+		UE_LOG(LogCustomEditorHotkeys, Warning, TEXT("\"%s\" has no target parameter to pass the actors through, its actors are skipped."), *GetPathNameSafe(Function));
+	}
+
+	Result.NumMatched = MatchingActors.Num();
+	if (MatchingActors.Num() == 0)
+	{
+		return Result;
+	}
+
+	const int32 BatchSize = FMath::Max(Settings.BatchSize, 1);
+	const int32 BatchesPerGarbageCollection = FMath::Max(Settings.BatchesPerGarbageCollection, 1);
+
+	FScopedSlowTask SlowTask(MatchingActors.Num(), FText::Format(LOCTEXT("RunningInWorldPartition", "Running {0} over {1} actors..."), FText::FromName(Settings.CommandName), MatchingActors.Num()));
+	SlowTask.MakeDialog(true);
+
+	for (int32 BatchStart = 0; BatchStart < MatchingActors.Num(); BatchStart += BatchSize)
+	{
+		if (SlowTask.ShouldCancel())
+		{
+			Result.bCancelled = true;
+			break;
+		}
+
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, MatchingActors.Num());
+		SlowTask.EnterProgressFrame(BatchEnd - BatchStart);
+
+		{
+			// Holding a reference keeps the actor loaded, releasing the batch's references unloads whatever nobody else needs
+			TArray<FWorldPartitionReference> BatchReferences;
+			BatchReferences.Reserve(BatchEnd - BatchStart);
+
+			TArray<AActor*> BatchActors;
+			BatchActors.Reserve(BatchEnd - BatchStart);
+
+			for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+			{
+				FWorldPartitionReference& Reference = BatchReferences.Emplace_GetRef(WorldPartition, MatchingActors[Index]);
+				if (AActor* Actor = Reference.IsValid() ? Reference->GetActor() : nullptr)
+				{
+					BatchActors.Add(Actor);
+				}
+			}
+
+			if (BatchActors.Num() > 0 && GEditor)
+			{
+				// The batch's transaction is dropped rather than committed, its records would otherwise keep every modified
+				// actor loaded. The changes stay, they just can't be undone, and the user's earlier undo history is kept.
+				const int32 TransactionIndex = GEditor->BeginTransaction(LOCTEXT("WorldPartitionRunBatch", "Custom command run over World Partition map"));
+				FCustomEditorHotkeysBlutilityExtensions::ExecuteActorUtilityFunctionOnActors(Settings.CommandName, BatchActors, &Settings.ParamValues);
+				GEditor->CancelTransaction(TransactionIndex);
+				Result.NumProcessed += BatchActors.Num();
+			}
+
+			// Saved before the references are released, an unloaded actor would lose its changes
+			TArray<UPackage*> DirtyPackages;
+			for (AActor* Actor : BatchActors)
+			{
+				UPackage* Package = Actor->GetExternalPackage();
+				if (Package && Package->IsDirty())
+				{
+					DirtyPackages.Add(Package);
+				}
+			}
+
+			if (DirtyPackages.Num() > 0)
+			{
+				UEditorLoadingAndSavingUtils::SavePackages(DirtyPackages, true);
+			}
+		}
+
+		if (++Result.NumBatches % BatchesPerGarbageCollection == 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	return Result;
+}
+
+#undef LOCTEXT_NAMESPACE
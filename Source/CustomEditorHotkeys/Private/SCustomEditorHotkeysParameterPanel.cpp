@@ -0,0 +1,342 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SCustomEditorHotkeysParameterPanel.h"
+#include "CustomEditorHotkeys.h"
+#include "CustomEditorHotkeysMacros.h"
+#include "CustomEditorHotkeysSettings.h"
+
+#include "AssetActionUtility.h"
+#include "EdGraphSchema_K2.h"
+#include "EditorUtilityObject.h"
+#include "Framework/Docking/TabManager.h"
+#include "IStructureDetailsView.h"
+#include "Modules/ModuleManager.h"
+#include "PropertyEditorModule.h"
+#include "UObject/GCObject.h"
+#include "UObject/StructOnScope.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Text/STextBlock.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
+
+#define LOCTEXT_NAMESPACE "FCustomEditorHotkeysModule"
+
+const FName SCustomEditorHotkeysParameterPanel::TabName(TEXT("CustomEditorHotkeysParameters"));
+
+TWeakPtr<SCustomEditorHotkeysParameterPanel> SCustomEditorHotkeysParameterPanel::ActivePanel;
+
+/**
+ * Parameter values of each function shown so far, filled with the function's defaults the first time it is shown.
+ * Object and asset parameters are reported to the garbage collector so a cached value never dangles.
+ */
+class FCustomEditorHotkeysParameterCache : public FGCObject
+{
+public:
+	TSharedPtr<FStructOnScope> FindOrAdd(UFunction* Function)
+	{
+		// Functions of recompiled utilities are gone, drop their values rather than keep them around
+		for (auto It = Params.CreateIterator(); It; ++It)
+		{
+			if (!It->Key.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		TSharedPtr<FStructOnScope>& FunctionParams = Params.FindOrAdd(Function);
+		if (!FunctionParams.IsValid())
+		{
+			FunctionParams = MakeShared<FStructOnScope>(Function);
+			for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+			{
+				FString Defaults;
+				if (UEdGraphSchema_K2::FindFunctionParameterDefaultValue(Function, *It, Defaults))
+				{
+					It->ImportText(*Defaults, It->ContainerPtrToValuePtr<uint8>(FunctionParams->GetStructMemory()), PPF_None, nullptr);
+				}
+			}
+		}
+
+		return FunctionParams;
+	}
+
+	void Reset()
+	{
+		Params.Reset();
+	}
+
+	//~ FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		for (TPair<TWeakObjectPtr<UFunction>, TSharedPtr<FStructOnScope>>& Pair : Params)
+		{
+			if (UFunction* Function = Pair.Key.Get())
+			{
+				Function->SerializeBin(Collector.GetVerySlowReferenceCollectorArchive(), Pair.Value->GetStructMemory());
+			}
+		}
+	}
+
+	virtual FString GetReferencerName() const override
+	{
+		return TEXT("FCustomEditorHotkeysParameterCache");
+	}
+
+private:
+	TMap<TWeakObjectPtr<UFunction>, TSharedPtr<FStructOnScope>> Params;
+};
+
+static TUniquePtr<FCustomEditorHotkeysParameterCache> ParameterCache;
+
+void SCustomEditorHotkeysParameterPanel::RegisterTabSpawner()
+{
+	ParameterCache = MakeUnique<FCustomEditorHotkeysParameterCache>();
+
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(TabName, FOnSpawnTab::CreateStatic(&SCustomEditorHotkeysParameterPanel::SpawnTab))
+		.SetDisplayName(LOCTEXT("ParameterPanelTabTitle", "Hotkey Parameters"))
+		.SetTooltipText(LOCTEXT("ParameterPanelTabTooltip", "Edit the parameters of custom commands without a modal dialog."))
+		.SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory());
+}
+
+void SCustomEditorHotkeysParameterPanel::UnregisterTabSpawner()
+{
+	if (FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(TabName);
+	}
+	ParameterCache.Reset();
+}
+
+TSharedRef<SDockTab> SCustomEditorHotkeysParameterPanel::SpawnTab(const FSpawnTabArgs& Args)
+{
+	TSharedRef<SCustomEditorHotkeysParameterPanel> Panel = SNew(SCustomEditorHotkeysParameterPanel);
+	ActivePanel = Panel;
+
+	return SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		[
+			Panel
+		];
+}
+
+bool SCustomEditorHotkeysParameterPanel::ShouldHandleCommand(TArrayView<const FFunctionAndUtil> Functions)
+{
+	return ParameterCache.IsValid()
+		&& GetDefault<UCustomEditorHotkeysSettings>()->bUseParameterPanel
+		&& Functions.ContainsByPredicate([](const FFunctionAndUtil& FunctionAndUtil) { return FunctionAndUtil.Function && FunctionAndUtil.Function->NumParms > 0; });
+}
+
+int32 SCustomEditorHotkeysParameterPanel::HandleCommand(TArrayView<const FFunctionAndUtil> Functions)
+{
+	TSharedPtr<SCustomEditorHotkeysParameterPanel> Panel = ActivePanel.Pin();
+	if (Panel.IsValid() && Panel->IsShowing(Functions))
+	{
+		return Panel->RunFunctions();
+	}
+
+	// Bring the tab up, spawning it the first time, then point it at the pressed overloads
+	FGlobalTabmanager::Get()->TryInvokeTab(TabName);
+	Panel = ActivePanel.Pin();
+	if (Panel.IsValid())
+	{
+		Panel->SetFunctions(Functions);
+		FSlateApplication::Get().SetKeyboardFocus(Panel, EFocusCause::SetDirectly);
+	}
+
+	return 0;
+}
+
+void SCustomEditorHotkeysParameterPanel::Construct(const FArguments& InArgs)
+{
+	FPropertyEditorModule& PropertyEditorModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>(TEXT("PropertyEditor"));
+
+	FDetailsViewArgs DetailsViewArgs;
+	DetailsViewArgs.bAllowSearch = false;
+	DetailsViewArgs.bHideSelectionTip = true;
+	DetailsViewArgs.NameAreaSettings = FDetailsViewArgs::HideNameArea;
+
+	FStructureDetailsViewArgs StructureViewArgs;
+	StructureViewArgs.bShowObjects = true;
+	StructureViewArgs.bShowAssets = true;
+	StructureViewArgs.bShowClasses = true;
+	StructureViewArgs.bShowInterfaces = true;
+
+	// Created once, pressing another command only retargets it
+	DetailsView = PropertyEditorModule.CreateStructureDetailView(DetailsViewArgs, StructureViewArgs, nullptr);
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.0f)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(this, &SCustomEditorHotkeysParameterPanel::GetTitleText)
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("NextOverloadButton", "Next Overload"))
+				.ToolTipText(LOCTEXT("NextOverloadButtonTooltip", "The command resolved to several utilities for the selection, show the parameters of the next one."))
+				.Visibility_Lambda([this]() { return ShownFunctions.Num() > 1 ? EVisibility::Visible : EVisibility::Collapsed; })
+				.OnClicked_Lambda([this]()
+					{
+						ShowNextFunction();
+						return FReply::Handled();
+					})
+			]
+		]
+		+ SVerticalBox::Slot()
+		.FillHeight(1.0f)
+		[
+			DetailsView->GetWidget().ToSharedRef()
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.HAlign(HAlign_Right)
+		.Padding(4.0f)
+		[
+			SNew(SButton)
+			.Text(LOCTEXT("RunButton", "Run"))
+			.ToolTipText(LOCTEXT("RunButtonTooltip", "Run the command with these parameters. Pressing its hotkey again or Enter does the same."))
+			.IsEnabled_Lambda([this]() { return ShownFunctions.Num() > 0; })
+			.OnClicked_Lambda([this]()
+				{
+					RunFunctions();
+					return FReply::Handled();
+				})
+		]
+	];
+}
+
+FReply SCustomEditorHotkeysParameterPanel::OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent)
+{
+	if (InKeyEvent.GetKey() == EKeys::Enter && ShownFunctions.Num() > 0)
+	{
+		RunFunctions();
+		return FReply::Handled();
+	}
+
+	return SCompoundWidget::OnKeyDown(MyGeometry, InKeyEvent);
+}
+
+void SCustomEditorHotkeysParameterPanel::SetFunctions(TArrayView<const FFunctionAndUtil> Functions)
+{
+	ShownFunctions.Reset(Functions.Num());
+	for (const FFunctionAndUtil& FunctionAndUtil : Functions)
+	{
+		ShownFunctions.Add({ FunctionAndUtil.Function, Cast<UObject>(FunctionAndUtil.Util) });
+	}
+
+	// Start on the first overload that actually has parameters to edit
+	const int32 FirstWithParams = Functions.IndexOfByPredicate([](const FFunctionAndUtil& FunctionAndUtil) { return FunctionAndUtil.Function->NumParms > 0; });
+	ShowFunction(FirstWithParams != INDEX_NONE ? FirstWithParams : 0);
+}
+
+bool SCustomEditorHotkeysParameterPanel::IsShowing(TArrayView<const FFunctionAndUtil> Functions) const
+{
+	if (Functions.Num() != ShownFunctions.Num())
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < Functions.Num(); ++Index)
+	{
+		if (!ShownFunctions[Index].Function.IsValid() || ShownFunctions[Index].Function.Get() != Functions[Index].Function)
+		{
+			return false;
+		}
+	}
+
+	return Functions.Num() > 0;
+}
+
+void SCustomEditorHotkeysParameterPanel::ShowFunction(int32 Index)
+{
+	ShownIndex = ShownFunctions.IsValidIndex(Index) ? Index : INDEX_NONE;
+
+	UFunction* Function = ShownIndex != INDEX_NONE ? ShownFunctions[ShownIndex].Function.Get() : nullptr;
+	DetailsView->SetStructureData(Function && ParameterCache.IsValid() ? ParameterCache->FindOrAdd(Function) : nullptr);
+}
+
+void SCustomEditorHotkeysParameterPanel::ShowNextFunction()
+{
+	if (ShownFunctions.Num() > 0)
+	{
+		ShowFunction((ShownIndex + 1) % ShownFunctions.Num());
+	}
+}
+
+int32 SCustomEditorHotkeysParameterPanel::RunFunctions()
+{
+	if (!ParameterCache.IsValid())
+	{
+		return 0;
+	}
+
+	// Running from the panel is a press of its own, inside a hotkey press the hotkey records the step instead
+	FCustomEditorHotkeysMacros::FScopedRecordedPress RecordedPress;
+
+	int32 NumExecuted = 0;
+	for (const FShownFunction& ShownFunction : ShownFunctions)
+	{
+		UFunction* FunctionToRun = ShownFunction.Function.Get();
+		UEditorUtilityObject* UtilToRun = Cast<UEditorUtilityObject>(ShownFunction.Util.Get());
+		if (!FunctionToRun || !UtilToRun)
+		{
+			continue;
+		}
+
+		// Only the values are copied, no widget is created for the run
+		const TSharedPtr<FStructOnScope> Values = ParameterCache->FindOrAdd(FunctionToRun);
+		const bool bExecuted = FCustomEditorHotkeysBlutilityExtensions::ExecuteUtilityFunction(FFunctionAndUtil(FunctionToRun, UtilToRun), nullptr,
+			[FunctionToRun, Values](void* ParamMemory)
+			{
+				for (TFieldIterator<FProperty> It(FunctionToRun); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+				{
+					It->CopyCompleteValue_InContainer(ParamMemory, Values->GetStructMemory());
+				}
+			});
+
+		if (bExecuted)
+		{
+			++NumExecuted;
+		}
+	}
+
+	// Overloads share the command name, the first one tells which editor the command belongs to
+	const FShownFunction* FirstShown = ShownFunctions.FindByPredicate([](const FShownFunction& ShownFunction) { return ShownFunction.Function.IsValid() && ShownFunction.Util.IsValid(); });
+	if (FirstShown)
+	{
+		FCustomEditorHotkeysMacros::RecordCommand(FirstShown->Function->GetFName(), FirstShown->Util->IsA<UAssetActionUtility>(), NumExecuted > 0);
+	}
+
+	return NumExecuted;
+}
+
+FText SCustomEditorHotkeysParameterPanel::GetTitleText() const
+{
+	const UFunction* ShownFunction = ShownFunctions.IsValidIndex(ShownIndex) ? ShownFunctions[ShownIndex].Function.Get() : nullptr;
+	if (!ShownFunction)
+	{
+		return LOCTEXT("NoCommandShown", "Press the hotkey of a custom command with parameters to edit them here.");
+	}
+
+	if (ShownFunctions.Num() == 1)
+	{
+		return ShownFunction->GetDisplayNameText();
+	}
+
+	return FText::Format(LOCTEXT("OverloadTitleFormat", "{0} ({1}, {2} of {3})"), ShownFunction->GetDisplayNameText(),
+		FText::FromString(GetNameSafe(ShownFunctions[ShownIndex].Util.Get())), ShownIndex + 1, ShownFunctions.Num());
+}
+
+#undef LOCTEXT_NAMESPACE
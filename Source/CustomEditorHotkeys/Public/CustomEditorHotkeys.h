@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 #include "ContentBrowserDelegates.h"
+#include "Containers/Ticker.h"
 
 class FToolBarBuilder;
 class FMenuBuilder;
@@ -24,8 +25,11 @@ public:
 
 private:
 	void ResetEditorCommands();
+	void ToggleMacroRecording();
 	void RegisterMenus();
 	void OnExtendContentBrowserCommands(TSharedRef<FUICommandList> CommandList, FOnContentBrowserGetSelection GetSelectionDelegate);
+	void OnSettingsChanged(UObject* Settings, struct FPropertyChangedEvent& PropertyChangedEvent);
+	void OnBlueprintCompiled();
 
 private:
 	TSharedPtr<class FUICommandList> PluginCommands;
@@ -34,4 +38,7 @@ private:
 
 	FDelegateHandle ContentBrowserCommandExtenderDelegateHandle;
 	FDelegateHandle AssetRegistryInitialLoadCompleteDelegateHandle;
+	FDelegateHandle SettingsChangedDelegateHandle;
+	FDelegateHandle BlueprintCompiledDelegateHandle;
+	FTSTicker::FDelegateHandle DeferredRefreshTickerHandle;
 };
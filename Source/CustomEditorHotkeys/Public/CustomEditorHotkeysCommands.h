@@ -6,6 +6,8 @@
 #include "Framework/Commands/Commands.h"
 #include "CustomEditorHotkeysStyle.h"
 
+class FCustomEditorHotkeysDispatchTable;
+
 class FCustomEditorHotkeysCommands : public TCommands<FCustomEditorHotkeysCommands>
 {
 public:
@@ -28,6 +30,39 @@ public:
 		return FCustomEditorHotkeysCommands::Get().CustomContentBrowserCommands;
 	}
 
+	static TMap<FName, TSharedPtr<FUICommandInfo>> GetCustomMacroCommands()
+	{
+		return FCustomEditorHotkeysCommands::Get().CustomMacroCommands;
+	}
+
+	/** Timings of the last custom command refresh, reported by the benchmark console commands */
+	struct FRefreshStats
+	{
+		int32 NumUtilityFunctions = 0;
+
+		/** Utility functions registered from asset registry tags, their blueprints weren't loaded */
+		int32 NumTaggedFunctions = 0;
+		int32 NumCommands = 0;
+		double GatherSeconds = 0.0;
+		double DispatchSeconds = 0.0;
+		double RegisterSeconds = 0.0;
+	};
+
+	static const FRefreshStats& GetLastRefreshStats()
+	{
+		return FCustomEditorHotkeysCommands::Get().LastRefreshStats;
+	}
+
+	static TSharedPtr<const FCustomEditorHotkeysDispatchTable> GetLevelEditorDispatchTable()
+	{
+		return FCustomEditorHotkeysCommands::Get().LevelEditorDispatchTable;
+	}
+
+	static TSharedPtr<const FCustomEditorHotkeysDispatchTable> GetContentBrowserDispatchTable()
+	{
+		return FCustomEditorHotkeysCommands::Get().ContentBrowserDispatchTable;
+	}
+
 protected:
 	friend class FCustomEditorHotkeysModule;
 
@@ -40,8 +75,16 @@ protected:
 
 public:
 	TSharedPtr<FUICommandInfo> PluginAction;
+	TSharedPtr<FUICommandInfo> ToggleMacroRecording;
 	TMap<FName, TSharedPtr<FUICommandInfo>> CustomLevelEditorCommands;
 	TMap<FName, TSharedPtr<FUICommandInfo>> CustomContentBrowserCommands;
+	TMap<FName, TSharedPtr<FUICommandInfo>> CustomMacroCommands;
+
+	/** Overloads of each custom command, resolved against the class of the selection when the command runs */
+	TSharedPtr<FCustomEditorHotkeysDispatchTable> LevelEditorDispatchTable;
+	TSharedPtr<FCustomEditorHotkeysDispatchTable> ContentBrowserDispatchTable;
+
+	FRefreshStats LastRefreshStats;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -69,6 +112,12 @@ public:
 
 public:
 	static void GetBlutilityClasses(TArray<FAssetData>& OutAssets, const FName& InClassName);
+
+	/** Forgets the cached derived class names, the next GetBlutilityClasses call asks the asset registry again */
+	static void InvalidateDerivedClassCache();
+
+	/** Drops cached state and stops listening for class hierarchy changes, called when the module shuts down */
+	static void ReleaseCaches();
 	static void CreateBlutilityActionsMenu(FMenuBuilder& MenuBuilder, TArray<class UEditorUtilityObject*> Utils);
 	static TArray<UEditorUtilityObject*> GetUtilitiesSupportedBySelectedActors(const TArray<AActor*>& SelectedActors);
 	static TArray<UEditorUtilityObject*> GetUtilitiesSupportedBySelectedAssets(const TArray<UObject*>& SelectedAssets);
@@ -77,5 +126,62 @@ public:
 	static void ExecuteUtilityFunctionByName(FName FunctionName, const TArray<UEditorUtilityObject*>& Utilities);
 	static void ExecuteActorUtilityFunctionByName(FName FunctionName);
 	static void ExecuteAssetUtilityFunctionByName(FName FunctionName);
-	static void ExecuteUtilityFunction(const FFunctionAndUtil& FunctionAndUtil);
+
+	/**
+	 * Runs a utility function on a temporary instance of its utility. Without ParamValues or PopulateParams the user is asked for
+	 * the parameters. PopulateParams is called on the parameter memory after the defaults and ParamValues were applied.
+	 * @return Whether the function ran, false if the user cancelled the parameter dialog.
+	 */
+	static bool ExecuteUtilityFunction(const FFunctionAndUtil& FunctionAndUtil, const TMap<FName, FString>* ParamValues = nullptr, TFunction<void(void* ParamMemory)> PopulateParams = nullptr);
+
+	/** Runs a custom command against the current selection, @return The number of overloads that ran */
+	static int32 ExecuteActorUtilityFunctionOnSelection(FName FunctionName, const TMap<FName, FString>* ParamValues = nullptr);
+	static int32 ExecuteAssetUtilityFunctionOnSelection(FName FunctionName, const TMap<FName, FString>* ParamValues = nullptr);
+
+	/**
+	 * Runs a custom command against explicit actors or assets rather than the user's selection, which is left untouched. The
+	 * targets are passed through the target parameter of each overload, see FindTargetParam. Overloads without one can only
+	 * read the selection and are skipped with a warning. Parameters are imported from ParamValues instead of prompting the user.
+	 * @return The number of overloads that ran.
+	 */
+	static int32 ExecuteActorUtilityFunctionOnActors(FName FunctionName, const TArray<AActor*>& Actors, const TMap<FName, FString>* ParamValues = nullptr);
+	static int32 ExecuteAssetUtilityFunctionOnAssets(FName FunctionName, const TArray<FAssetData>& Assets, const TMap<FName, FString>* ParamValues = nullptr);
+
+	/** Utility function metadata naming the image used for its command's icon */
+	static const FName NAME_HotkeyIcon;
+
+	/** Utility function metadata naming the parameter explicit targets are passed through */
+	static const FName NAME_HotkeyTargets;
+
+	/** Parameter explicit targets are passed through when the function has no HotkeyTargets metadata */
+	static const FName NAME_DefaultTargetParam;
+
+	/**
+	 * @return The designated target parameter if every target class fits in it: an input array of, or a single, object reference
+	 * named by the HotkeyTargets metadata, or named Targets.
+	 */
+	static FProperty* FindTargetParam(const UFunction* Function, TArrayView<const UClass* const> TargetClasses);
+
+	/** @return Whether ParamValues leave the target parameter to the targets, logs an error when it was set explicitly as well */
+	static bool IsTargetParamFree(const UFunction* Function, const FProperty* TargetParam, const TMap<FName, FString>* ParamValues);
+
+	/** Writes the targets into a parameter found by FindTargetParam, a single object parameter takes the first target */
+	static void SetTargetParam(const FProperty* TargetParam, void* ParamMemory, TArrayView<UObject* const> Targets);
+
+private:
+	/** Explicit target of a command, assets are only loaded once an overload can take them */
+	struct FExplicitTarget
+	{
+		const UClass* DispatchClass = nullptr;
+
+		/** Class of the object passed to the target parameter, the asset's own class for blueprint assets */
+		const UClass* ObjectClass = nullptr;
+
+		UObject* Object = nullptr;
+		const FAssetData* AssetData = nullptr;
+	};
+
+	static int32 ExecuteUtilityFunctionOnTargets(FName FunctionName, const TSharedPtr<const FCustomEditorHotkeysDispatchTable>& DispatchTable, TArrayView<FExplicitTarget> Targets, const TMap<FName, FString>* ParamValues);
+
+	static int32 ExecuteUtilityFunctionForClasses(FName FunctionName, const TSharedPtr<const FCustomEditorHotkeysDispatchTable>& DispatchTable, TArrayView<const UClass* const> TargetClasses, const TMap<FName, FString>* ParamValues = nullptr);
 };
\ No newline at end of file
@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/SoftObjectPath.h"
+#include "CustomEditorHotkeysCommands.h"
+
+/**
+ * Pre-order numbering of the loaded class hierarchy. Every indexed class owns the half-open range [Begin, End)
+ * which covers itself and all of its children, so a class hierarchy test becomes a pair of integer compares.
+ */
+class FCustomEditorHotkeysClassIndex
+{
+public:
+	struct FRange
+	{
+		int32 Begin = INDEX_NONE;
+		int32 End = INDEX_NONE;
+
+		bool IsValid() const { return Begin != INDEX_NONE; }
+		bool Contains(int32 Index) const { return Index >= Begin && Index < End; }
+	};
+
+	/** Renumbers every class that is currently loaded */
+	void Rebuild();
+
+	/** @return The range of the class, or of its closest indexed ancestor if the class was created after the last rebuild */
+	FRange GetRange(const UClass* Class) const;
+
+	/** @return The range of the class itself, invalid if it was created after the last rebuild */
+	FRange FindExactRange(const UClass* Class) const;
+
+	int32 Num() const { return NumClasses; }
+
+private:
+	TMap<const UClass*, FRange> Ranges;
+	int32 NumClasses = 0;
+};
+
+/**
+ * Maps a custom command name to every utility function registered under that name, keyed by the class the utility supports.
+ * The same chord can therefore run a different function depending on the class of the selection it is pressed with.
+ */
+class FCustomEditorHotkeysDispatchTable
+{
+public:
+	using FFunctionAndUtil = FCustomEditorHotkeysBlutilityExtensions::FFunctionAndUtil;
+
+	struct FOverload
+	{
+		FOverload(const FFunctionAndUtil& InFunctionAndUtil, const UClass* InSupportedClass);
+		FOverload(FName InFunctionName, const FSoftClassPath& InUtilityClass, const UClass* InSupportedClass);
+
+		/** Loads the utility class of an overload registered from asset registry tags, does nothing once loaded */
+		void Load() const;
+
+		/** Whether the function or its utility was destroyed or replaced by a blueprint recompile since it was loaded */
+		bool IsStale() const;
+
+		/** Null until the overload is loaded */
+		mutable FFunctionAndUtil FunctionAndUtil;
+
+		/** Tracks the raw pointers above, which are left dangling once a recompile garbage collects the old class */
+		mutable FWeakObjectPtr WeakFunction;
+		mutable FWeakObjectPtr WeakUtil;
+
+		/** Function and utility class to load on first use, when the overload was registered without loading its blueprint */
+		FName FunctionName;
+		FSoftClassPath UtilityClass;
+		mutable bool bLoaded;
+
+		/** Class the utility was written for, null if it supports any class */
+		const UClass* SupportedClass;
+
+		FCustomEditorHotkeysClassIndex::FRange Range;
+	};
+
+	explicit FCustomEditorHotkeysDispatchTable(TSharedRef<const FCustomEditorHotkeysClassIndex> InClassIndex);
+
+	/** Adds an overload to the command. Fails if the command already has an overload for the same supported class. */
+	bool AddOverload(FName CommandName, const FFunctionAndUtil& FunctionAndUtil, const UClass* SupportedClass);
+
+	/** Adds an overload whose utility blueprint is only loaded when the command first resolves to it */
+	bool AddOverload(FName CommandName, const FSoftClassPath& UtilityClass, const UClass* SupportedClass);
+
+	/** Flattens the overload ranges of every command into lookup segments. Must be called once all overloads have been added. */
+	void Finalize();
+
+	/**
+	 * @return The overload of the command written for the most derived class the target is a child of, null if there is none.
+	 * Loads the overload's utility blueprint if it was registered from asset registry tags.
+	 */
+	const FFunctionAndUtil* Resolve(FName CommandName, const UClass* TargetClass) const;
+
+	/** Resolves the command for each target class, every overload is only returned once */
+	void ResolveAll(FName CommandName, TArrayView<const UClass* const> TargetClasses, TArray<FFunctionAndUtil>& OutFunctions) const;
+
+	const TArray<FOverload>* FindOverloads(FName CommandName) const;
+
+	bool Contains(FName CommandName) const { return Commands.Contains(CommandName); }
+
+	/** @return Whether any overload went stale, the commands need to be refreshed to pick up the recompiled utilities */
+	bool HasStaleOverloads() const;
+
+private:
+	struct FSegment
+	{
+		int32 Begin;
+		int32 End;
+		int32 Overload;
+	};
+
+	struct FCommandEntry
+	{
+		TArray<FOverload> Overloads;
+
+		/** Disjoint, sorted class index ranges each mapped to the innermost overload covering them */
+		TArray<FSegment> Segments;
+
+		/** Classes already resolved against this command, INDEX_NONE when no overload supports them */
+		mutable TMap<TObjectKey<UClass>, int32> ResolvedClasses;
+	};
+
+	TSharedRef<const FCustomEditorHotkeysClassIndex> ClassIndex;
+	TMap<FName, FCommandEntry> Commands;
+};
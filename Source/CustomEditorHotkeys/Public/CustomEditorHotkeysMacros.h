@@ -0,0 +1,52 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FCustomEditorHotkeysMacro;
+class UFunction;
+
+/**
+ * Records custom command invocations into macros and replays them. Recorded steps keep the parameter values that were
+ * entered, so a replay never shows the parameter dialog.
+ */
+class FCustomEditorHotkeysMacros
+{
+public:
+	/**
+	 * Marks a custom command press. Parameters are only collected for utilities run inside a press, so runs from the remote
+	 * trigger, the subsystem or scripts never end up in a recorded step. Presses nest, only the outermost one adds a step.
+	 */
+	struct FScopedRecordedPress
+	{
+		FScopedRecordedPress();
+		~FScopedRecordedPress();
+	};
+
+	static void StartRecording();
+
+	/** Stops recording and saves the macro to the user settings, returns its name or NAME_None when nothing was recorded */
+	static FName StopRecording(FName MacroName = NAME_None);
+
+	static bool IsRecording();
+
+	/** Called after a utility function ran with the given parameter memory, the values are kept for the step of the current press */
+	static void RecordParams(const UFunction* Function, const void* Params);
+
+	/** Called once a custom command press finished, adds a step while recording */
+	static void RecordCommand(FName CommandName, bool bContentBrowserCommand, bool bExecuted);
+
+	/** Replays the macro saved under the given name */
+	static void ReplayMacro(FName MacroName);
+
+	/**
+	 * Replays every step of a macro in a single transaction. The selection is read once and every step is resolved up front,
+	 * so a step that changes the selection doesn't change what the following steps dispatch to. Returns the number of
+	 * utility functions and script commands run.
+	 */
+	static int32 ReplayMacro(const FCustomEditorHotkeysMacro& Macro);
+
+	/** Name of the command registered for a macro */
+	static FName GetMacroCommandName(FName MacroName);
+};
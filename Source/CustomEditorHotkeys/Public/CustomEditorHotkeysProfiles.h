@@ -0,0 +1,47 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Framework/Commands/InputChord.h"
+
+/**
+ * Keybinding profiles for the custom commands, stored as JSON:
+ *   { "Bindings": [ { "Command": "AlignToFloor", "Primary": "Ctrl+Shift+F", "Secondary": "" }, ... ] }
+ * A profile is applied in a single pass with one write of the user's key bindings, however many commands it binds.
+ */
+class FCustomEditorHotkeysProfiles
+{
+public:
+	/** A chord bound to more than one command that can be active at the same time */
+	struct FChordConflict
+	{
+		FInputChord Chord;
+
+		/** Binding context and command name of every command bound to the chord */
+		TArray<TPair<FName, FName>> Commands;
+	};
+
+	struct FImportResult
+	{
+		int32 NumApplied = 0;
+		int32 NumUnknownCommands = 0;
+		TArray<FChordConflict> Conflicts;
+		double Seconds = 0.0;
+	};
+
+	/** Writes the active chords of every custom command, returns false if the file could not be written */
+	static bool ExportProfile(const FString& FilePath);
+
+	/** Applies the chords of a profile file, commands the profile doesn't mention keep their chords */
+	static bool ImportProfile(const FString& FilePath, FImportResult& OutResult);
+
+	/**
+	 * Indexes the active chords of every binding context and returns the chords shared by more than one command, at least
+	 * one of them a custom command. Custom commands run alongside the level editor and content browser commands, so a
+	 * clash with any other context is reported as well.
+	 */
+	static void FindConflicts(TArray<FChordConflict>& OutConflicts);
+
+	static void LogConflicts(const TArray<FChordConflict>& Conflicts);
+};
@@ -0,0 +1,89 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FFileChangeData;
+
+/**
+ * Turns Python scripts from the configured directories into custom commands. Every top-level function of a script that
+ * takes no arguments becomes a command named Py_<Script>_<Function>.
+ *
+ * A script is compiled and its top level run once, like an import; hotkeys then call straight into the cached functions.
+ * The cache entry of a script is dropped when the file changes on disk, and the commands are refreshed when the set of
+ * entry points changed.
+ *
+ * The Python Editor Script Plugin is optional. Its module is loaded at runtime, and without it no script commands are
+ * registered.
+ */
+class FCustomEditorHotkeysPythonScripts
+{
+public:
+	struct FEntryPoint
+	{
+		FName CommandName;
+
+		/** Absolute path of the script, with forward slashes */
+		FString ScriptPath;
+
+		FString FunctionName;
+
+		/** First line of the function's docstring, or where the function comes from when it has none */
+		FString Description;
+
+		bool bContentBrowserCommand = false;
+	};
+
+	/** Scans and watches the directories listed in the plugin settings, replacing any previous state. Does nothing without Python. */
+	static void Initialize();
+
+	static void Shutdown();
+
+	static bool IsInitialized() { return Instance.IsValid(); }
+
+	static FCustomEditorHotkeysPythonScripts& Get();
+
+	/** Whether the Python Editor Script Plugin is enabled and can run scripts */
+	static bool IsPythonAvailable();
+
+	/** Runs the script function registered under the command name, returns whether it ran without raising */
+	static bool RunScriptCommand(FName CommandName);
+
+	/** Hotkey action of a script command, records the press into a macro being recorded */
+	static void ExecuteScriptCommandByName(FName CommandName);
+
+	~FCustomEditorHotkeysPythonScripts();
+
+	const TArray<FEntryPoint>& GetEntryPoints() const { return EntryPoints; }
+
+	const FEntryPoint* FindEntryPoint(FName CommandName) const;
+
+private:
+	FCustomEditorHotkeysPythonScripts() = default;
+
+	/** Rebuilds the entry points from the script directories, returns whether the set of commands changed */
+	bool Rescan();
+
+	void ScanScript(const FString& ScriptPath, bool bContentBrowserCommand);
+
+	void WatchDirectory(const FString& Directory);
+
+	void OnDirectoryChanged(const TArray<FFileChangeData>& FileChanges);
+
+	/** Installs the Python side of the code cache, once per editor session */
+	bool EnsureCodeCache();
+
+	/** Drops cached code of the given script, or of every script when the path is empty */
+	void InvalidateCodeCache(const FString& ScriptPath);
+
+private:
+	TArray<FEntryPoint> EntryPoints;
+	TMap<FName, int32> EntryPointIndices;
+
+	TArray<TPair<FString, FDelegateHandle>> DirectoryWatchers;
+
+	static bool bCodeCacheInstalled;
+
+	static TSharedPtr<FCustomEditorHotkeysPythonScripts> Instance;
+};
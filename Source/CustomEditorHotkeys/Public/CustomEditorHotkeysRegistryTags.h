@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/SoftObjectPath.h"
+
+struct FAssetData;
+
+/**
+ * Records the hotkeyable functions of utility blueprints in an asset registry tag when they are saved, so the custom
+ * commands can be registered from the registry alone:
+ *   { "Version": 1, "SupportedClass": "/Script/Engine.StaticMeshActor",
+ *     "Functions": [ { "Name": "AlignToFloor", "DisplayName": "Align To Floor", "NumParms": 0, "Description": "", "Icon": "" }, ... ] }
+ * Blueprints saved before the tag existed have to be loaded to find their functions, resaving them adds the tag.
+ */
+class FCustomEditorHotkeysRegistryTags
+{
+public:
+	struct FTaggedFunction
+	{
+		FName Name;
+		FString DisplayName;
+		int32 NumParms = 0;
+		FString Description;
+		FString IconPath;
+	};
+
+	struct FTaggedUtility
+	{
+		/** Generated class of the blueprint, loaded the first time one of its commands runs */
+		FSoftClassPath UtilityClass;
+
+		/** Class the utility was written for, null if it supports any class */
+		FSoftClassPath SupportedClass;
+
+		TArray<FTaggedFunction> Functions;
+	};
+
+	static const FName NAME_HotkeyFunctionsTag;
+
+	static void Register();
+	static void Unregister();
+
+	/** @return Whether the asset has an up to date tag, false if it has to be loaded to find its functions */
+	static bool ReadTag(const FAssetData& Asset, FTaggedUtility& OutUtility);
+
+private:
+	static void OnGetExtraObjectTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& InOutTags);
+
+	static FDelegateHandle ExtraObjectTagsHandle;
+};
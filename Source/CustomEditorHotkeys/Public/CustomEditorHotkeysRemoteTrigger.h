@@ -0,0 +1,132 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+
+class FSocket;
+class FTcpListener;
+struct FIPv4Endpoint;
+
+/**
+ * Localhost endpoint letting external tools (macro pads, scripts) run custom commands through the same dispatch tables as hotkeys.
+ *
+ * The protocol is one UTF-8 request per line, every request gets exactly one reply line in the order it was received.
+ * The first line of a connection has to be the session token, which is regenerated every time the endpoint starts and
+ * written to Saved/CustomEditorHotkeys/RemoteTrigger.token:
+ *   AUTH <Token>                                          -> AUTHED
+ *   PING                                                  -> PONG
+ *   RUN <Command> [ACTORS <Path>...] [ASSETS <Path>...] [PARAM <Name>=<Value>...]
+ *                                                         -> OK <Command> <OverloadsRun> <ExecuteMs> <QueuedMs>
+ *                                                         -> ERR <Command> <Reason>
+ * Without ACTORS or ASSETS the command runs on the current selection. ACTORS and ASSETS leave the selection alone and are
+ * passed through the target parameter of each overload, overloads that can only read the selection don't run on them.
+ * Tokens containing spaces can be quoted. Parameters that aren't passed keep their default values, no dialog is shown.
+ * Python script commands run on their own and take no ACTORS, ASSETS or PARAM. A missing or wrong token, or a malformed
+ * or unknown request, gets an error reply and the connection is closed without running anything queued after it.
+ *
+ * Sockets are serviced on a worker thread, requests are queued and run in batches on the game thread.
+ */
+class FCustomEditorHotkeysRemoteTrigger : public FRunnable
+{
+public:
+	/** Starts or stops the endpoint to match the plugin settings */
+	static void Initialize();
+
+	static void Shutdown();
+
+	static bool IsRunning() { return Instance.IsValid(); }
+
+	static FCustomEditorHotkeysRemoteTrigger& Get();
+
+	/** Queues a request as if a client had sent it. The reply is passed to OnReply on the game thread. */
+	void SubmitLocal(const FString& Line, TFunction<void(const FString&)> OnReply);
+
+	virtual ~FCustomEditorHotkeysRemoteTrigger();
+
+	//~ FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	struct FConnection
+	{
+		int32 Id;
+		FSocket* Socket;
+		TArray<uint8> PendingInput;
+		bool bAuthenticated = false;
+
+		/** Sent an unknown request, nothing more is read until its reply closes the connection */
+		bool bRejected = false;
+	};
+
+	struct FRequest
+	{
+		int32 ConnectionId;
+		FString Line;
+		double ReceivedTime;
+		TFunction<void(const FString&)> LocalReply;
+
+		/** Not a request, the worker closed the connection and nothing more will be queued for it */
+		bool bConnectionClosed = false;
+	};
+
+	struct FReply
+	{
+		int32 ConnectionId;
+		FString Line;
+
+		/** Close the connection once the reply is sent */
+		bool bClose;
+	};
+
+	FCustomEditorHotkeysRemoteTrigger(int32 InPort, int32 InMaxRequestsPerTick);
+
+	bool Start();
+	bool OnConnectionAccepted(FSocket* Socket, const FIPv4Endpoint& Endpoint);
+	bool Tick(float DeltaTime);
+
+	/** Runs a single request on the game thread and builds its reply, bOutMalformed is set if the request couldn't be parsed */
+	FString ProcessRequest(const FRequest& Request, bool& bOutMalformed) const;
+
+	static FString GetTokenFilePath();
+
+	/** Worker thread helpers */
+	void ReadConnection(FConnection& Connection);
+	void SendLine(FConnection& Connection, const FString& Line);
+	void CloseConnection(FConnection& Connection);
+
+private:
+	int32 Port;
+	int32 MaxRequestsPerTick;
+
+	/** Set before the worker thread starts, read-only afterwards */
+	FString SessionToken;
+
+	TUniquePtr<FTcpListener> Listener;
+	FRunnableThread* Thread = nullptr;
+	FThreadSafeBool bStopping;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/** Listener thread -> worker thread */
+	TQueue<FSocket*, EQueueMode::Mpsc> AcceptedSockets;
+
+	/** Worker thread and local submissions -> game thread */
+	TQueue<FRequest, EQueueMode::Mpsc> Requests;
+
+	/** Game thread -> worker thread */
+	TQueue<FReply, EQueueMode::Spsc> Replies;
+
+	/** Only touched by the worker thread */
+	TArray<FConnection> Connections;
+	int32 NextConnectionId = 0;
+
+	/** Connections that sent a malformed request, until their close comes through the queue. Only touched by the game thread. */
+	TSet<int32> RejectedConnections;
+
+	static TSharedPtr<FCustomEditorHotkeysRemoteTrigger> Instance;
+};
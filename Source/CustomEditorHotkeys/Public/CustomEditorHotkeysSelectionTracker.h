@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "AssetRegistry/AssetData.h"
+
+/**
+ * Class-bucketed view of the level editor and content browser selections. It is kept up to date from the selection
+ * delegates, so dispatching a custom command does not have to walk the whole selection on every key press.
+ */
+class FCustomEditorHotkeysSelectionTracker
+{
+public:
+	template<typename ObjectType>
+	struct TClassBucket
+	{
+		TWeakObjectPtr<UClass> Class;
+		TArray<ObjectType> Objects;
+	};
+
+	using FActorBucket = TClassBucket<TWeakObjectPtr<AActor>>;
+	using FAssetBucket = TClassBucket<FAssetData>;
+
+	static void Initialize();
+
+	static void Shutdown();
+
+	static bool IsInitialized() { return Instance.IsValid(); }
+
+	static const FCustomEditorHotkeysSelectionTracker& Get();
+
+	~FCustomEditorHotkeysSelectionTracker();
+
+	/** @return Selected level actors bucketed by their class */
+	const TMap<TObjectKey<UClass>, FActorBucket>& GetSelectedActors() const;
+
+	/** @return Assets selected in the primary content browser, bucketed by the class custom commands are resolved against */
+	const TMap<TObjectKey<UClass>, FAssetBucket>& GetSelectedAssets() const;
+
+	void GetSelectedActorClasses(TArray<const UClass*>& OutClasses) const;
+	void GetSelectedAssetClasses(TArray<const UClass*>& OutClasses) const;
+
+	/** @return The class used to resolve custom commands for an asset, blueprints resolve to the class they generate */
+	static UClass* GetDispatchClass(const FAssetData& AssetData);
+
+private:
+	FCustomEditorHotkeysSelectionTracker();
+
+	void OnObjectSelected(UObject* Object);
+	void OnSelectionChanged(UObject* Selection);
+	void OnSelectNone();
+	void OnAssetSelectionChanged(const TArray<FAssetData>& NewSelectedAssets, bool bIsPrimaryBrowser);
+
+	void AddActor(AActor* Actor) const;
+	void RemoveActor(AActor* Actor) const;
+	void SetSelectedAssets(const TArray<FAssetData>& SelectedAssets) const;
+
+	/** Rebuilds the buckets from scratch, only needed after bulk selection changes we could not follow incrementally */
+	void SynchronizeActors() const;
+	void SynchronizeAssets() const;
+
+private:
+	mutable TMap<TObjectKey<UClass>, FActorBucket> ActorBuckets;
+	mutable TMap<TObjectKey<UClass>, FAssetBucket> AssetBuckets;
+	mutable bool bActorsDirty = true;
+	mutable bool bAssetsDirty = true;
+
+	/** Whether an actor was selected or deselected since the last selection change notification */
+	bool bActorEventsSinceChange = false;
+
+	FDelegateHandle SelectObjectDelegateHandle;
+	FDelegateHandle SelectionChangedDelegateHandle;
+	FDelegateHandle SelectNoneDelegateHandle;
+	FDelegateHandle AssetSelectionChangedDelegateHandle;
+
+	static TSharedPtr<FCustomEditorHotkeysSelectionTracker> Instance;
+};
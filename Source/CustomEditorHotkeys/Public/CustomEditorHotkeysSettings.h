@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "CustomEditorHotkeysSettings.generated.h"
+
+/** One recorded custom command invocation */
+USTRUCT()
+struct FCustomEditorHotkeysMacroStep
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Macro")
+	FName CommandName;
+
+	/** Whether the command was run from the content browser rather than the level editor */
+	UPROPERTY(EditAnywhere, Category = "Macro")
+	bool bContentBrowserCommand = false;
+
+	/** Parameter values entered when the step was recorded, as exported text */
+	UPROPERTY(EditAnywhere, Category = "Macro")
+	TMap<FName, FString> ParamValues;
+};
+
+/** A sequence of custom commands replayed back-to-back from a single chord */
+USTRUCT()
+struct FCustomEditorHotkeysMacro
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Macro")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, Category = "Macro")
+	TArray<FCustomEditorHotkeysMacroStep> Steps;
+};
+
+/** Per-user settings of the Custom Editor Hotkeys plugin */
+UCLASS(config = EditorPerProjectUserSettings, meta = (DisplayName = "Custom Editor Hotkeys"))
+class CUSTOMEDITORHOTKEYS_API UCustomEditorHotkeysSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UCustomEditorHotkeysSettings();
+
+	//~ UDeveloperSettings interface
+	virtual FName GetContainerName() const override { return TEXT("Editor"); }
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+
+	/**
+	 * Icons shown for custom commands in menus and toolbars, keyed by function name. Relative paths start at the project directory.
+	 * Native utility functions can declare theirs with the HotkeyIcon metadata instead.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Commands", meta = (FilePathFilter = "Image files (*.png;*.svg)|*.png;*.svg"))
+	TMap<FName, FFilePath> CommandIcons;
+
+	/**
+	 * Edit the parameters of custom commands in the dockable Hotkey Parameters tab instead of a modal dialog.
+	 * The first press of a hotkey shows its parameters, pressing it again or Enter in the tab runs the command.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Commands")
+	bool bUseParameterPanel;
+
+	/** Recorded hotkey macros, each is registered as a command that can be bound to its own chord */
+	UPROPERTY(config, EditAnywhere, Category = "Macros")
+	TArray<FCustomEditorHotkeysMacro> Macros;
+
+	/** Directories searched for Python scripts whose functions become level editor commands. Relative paths start at the project directory. Needs the Python Editor Script Plugin. */
+	UPROPERTY(config, EditAnywhere, Category = "Python Scripts", meta = (RelativeToGameDir))
+	TArray<FDirectoryPath> LevelEditorPythonScriptDirectories;
+
+	/** Directories searched for Python scripts whose functions become content browser commands. Relative paths start at the project directory. Needs the Python Editor Script Plugin. */
+	UPROPERTY(config, EditAnywhere, Category = "Python Scripts", meta = (RelativeToGameDir))
+	TArray<FDirectoryPath> ContentBrowserPythonScriptDirectories;
+
+	/** Accept "run command" requests from local tools such as macro pads or scripts on a localhost TCP port */
+	UPROPERTY(config, EditAnywhere, Category = "Remote Trigger")
+	bool bEnableRemoteTrigger;
+
+	/** Port the remote trigger listens on, only connections from this machine are accepted */
+	UPROPERTY(config, EditAnywhere, Category = "Remote Trigger", meta = (EditCondition = "bEnableRemoteTrigger", ClampMin = "1024", ClampMax = "65535"))
+	int32 RemoteTriggerPort;
+
+	/** Maximum number of queued requests run per editor tick, the rest of a burst waits for the next tick */
+	UPROPERTY(config, EditAnywhere, Category = "Remote Trigger", meta = (EditCondition = "bEnableRemoteTrigger", ClampMin = "1"))
+	int32 MaxRemoteRequestsPerTick;
+};
@@ -0,0 +1,28 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CustomEditorHotkeysSoakTestCommandlet.generated.h"
+
+/**
+ * Headless soak test of the hotkey execution path. Fires a randomized sequence of custom commands, selection changes,
+ * command refreshes and utility blueprint recompiles, and fails when object counts, rooted objects, memory, peak memory
+ * or per-press latency keep growing.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=CustomEditorHotkeysSoakTest -nullrhi [-Map=<Package>] [-Iterations=5000] [-Seed=0]
+ *        [-SampleEvery=250] [-MaxObjectGrowth=1000] [-MaxRootedGrowth=0] [-MaxMemoryGrowthMB=256]
+ *        [-MaxPeakGrowthMB=512] [-MaxLatencyDrift=0.5]
+ */
+UCLASS()
+class UCustomEditorHotkeysSoakTestCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCustomEditorHotkeysSoakTestCommandlet();
+
+	//~ UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+};
@@ -13,8 +13,11 @@ public:
 
 	static void Shutdown();
 
-	/** reloads textures used by slate renderer */
-	static void ReloadTextures();
+	/** Declares the image shown for a custom command icon key. Nothing is loaded until the icon is first displayed. */
+	static void SetCommandIcon(FName IconKey, const FString& ImagePath);
+
+	/** Forgets every declared command icon, brushes already created stay cached for the widgets still using them */
+	static void ClearCommandIcons();
 
 	/** @return The Slate style set for the Shooter game */
 	static const ISlateStyle& Get();
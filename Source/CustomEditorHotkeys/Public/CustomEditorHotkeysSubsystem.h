@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "AssetRegistry/AssetData.h"
+#include "CustomEditorHotkeysSubsystem.generated.h"
+
+class AActor;
+
+/** Outcome of one custom command on one target */
+USTRUCT(BlueprintType)
+struct FCustomEditorHotkeysTargetResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Custom Editor Hotkeys")
+	FName CommandName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Custom Editor Hotkeys")
+	FSoftObjectPath Target;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Custom Editor Hotkeys")
+	bool bSucceeded = false;
+
+	/** Time spent running the command, shared evenly between targets handed to the utility in a single call */
+	UPROPERTY(BlueprintReadOnly, Category = "Custom Editor Hotkeys")
+	float Milliseconds = 0.0f;
+
+	/** Why the command did not run, empty on success */
+	UPROPERTY(BlueprintReadOnly, Category = "Custom Editor Hotkeys")
+	FString Error;
+};
+
+USTRUCT(BlueprintType)
+struct FCustomEditorHotkeysBatchResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Custom Editor Hotkeys")
+	TArray<FCustomEditorHotkeysTargetResult> Results;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Custom Editor Hotkeys")
+	int32 NumSucceeded = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Custom Editor Hotkeys")
+	int32 NumFailed = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Custom Editor Hotkeys")
+	float TotalMilliseconds = 0.0f;
+};
+
+/**
+ * Runs custom commands on explicit targets from Blueprint, Python or C++ tools, through the same dispatch tables as the hotkeys.
+ *
+ * Targets are grouped by the overload they resolve to and each group is handed to its utility function in one call. The
+ * selection is never changed: targets are passed through the function's target parameter, an array of, or a single, actor
+ * or asset reference named Targets or by the function's HotkeyTargets metadata. Utilities without one can only read the
+ * selection and fail for explicit targets, as do Python script commands, which take no targets; run those from their
+ * hotkey or the remote trigger. Setting the target parameter in ParamValues as well is an error.
+ */
+UCLASS()
+class CUSTOMEDITORHOTKEYS_API UCustomEditorHotkeysSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Runs each level editor command in turn on the actors, optionally inside a single undo transaction */
+	UFUNCTION(BlueprintCallable, Category = "Custom Editor Hotkeys", meta = (AutoCreateRefTerm = "ParamValues"))
+	FCustomEditorHotkeysBatchResult RunCommandsOnActors(const TArray<FName>& CommandNames, const TArray<AActor*>& Actors, const TMap<FName, FString>& ParamValues, bool bSingleTransaction = true);
+
+	/** Runs each content browser command in turn on the assets, optionally inside a single undo transaction */
+	UFUNCTION(BlueprintCallable, Category = "Custom Editor Hotkeys", meta = (AutoCreateRefTerm = "ParamValues"))
+	FCustomEditorHotkeysBatchResult RunCommandsOnAssets(const TArray<FName>& CommandNames, const TArray<FAssetData>& Assets, const TMap<FName, FString>& ParamValues, bool bSingleTransaction = true);
+
+	/** Same as RunCommandsOnAssets, with assets given by object path such as /Game/Props/SM_Crate.SM_Crate */
+	UFUNCTION(BlueprintCallable, Category = "Custom Editor Hotkeys", meta = (AutoCreateRefTerm = "ParamValues"))
+	FCustomEditorHotkeysBatchResult RunCommandsOnAssetPaths(const TArray<FName>& CommandNames, const TArray<FString>& AssetPaths, const TMap<FName, FString>& ParamValues, bool bSingleTransaction = true);
+
+private:
+	struct FTarget
+	{
+		FSoftObjectPath Path;
+
+		/** Class the command is resolved against, null if the target doesn't exist */
+		const UClass* DispatchClass = nullptr;
+
+		/** Class of the object passed to a utility's parameter, the asset's own class for blueprint assets */
+		const UClass* ObjectClass = nullptr;
+
+		/** Assets are only loaded when they are passed to a utility as a parameter */
+		UObject* Object = nullptr;
+		FAssetData AssetData;
+	};
+
+	FCustomEditorHotkeysBatchResult RunCommands(const TArray<FName>& CommandNames, TArray<FTarget>& Targets, bool bContentBrowserCommands, const TMap<FName, FString>& ParamValues, bool bSingleTransaction);
+};
@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/**
+ * Runs an actor custom command over a World Partition map without loading it all. Compatible actors are found from their
+ * actor descriptors, then streamed in, processed, saved and unloaded in bounded batches. The actors are passed through the
+ * command's target parameter, the selection is left alone. Each batch's transaction is dropped once it ran, since it would
+ * otherwise keep every modified actor loaded, so the run can't be undone but the undo history from before it is kept.
+ */
+class FCustomEditorHotkeysWorldPartitionRunner
+{
+public:
+	struct FSettings
+	{
+		FName CommandName;
+
+		/** Only actors whose bounds intersect the region are processed, the whole map when unset */
+		TOptional<FBox> Region;
+
+		/** Only actors of this class or its children are processed, any class the command supports when null */
+		const UClass* ClassFilter = nullptr;
+
+		/** Number of actors loaded at once */
+		int32 BatchSize = 100;
+
+		/** Garbage is collected after this many batches */
+		int32 BatchesPerGarbageCollection = 1;
+
+		/** Parameter values, the function defaults are used for anything missing. The parameter dialog is never shown. */
+		TMap<FName, FString> ParamValues;
+	};
+
+	struct FResult
+	{
+		int32 NumMatched = 0;
+
+		/** Actors whose overload has no target parameter, they were not loaded */
+		int32 NumUnsupported = 0;
+		int32 NumProcessed = 0;
+		int32 NumBatches = 0;
+		bool bCancelled = false;
+	};
+
+	/** Runs the command on every matching actor of the world, showing a cancellable progress dialog */
+	static FResult Run(UWorld* World, const FSettings& Settings);
+};
@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "CustomEditorHotkeysCommands.h"
+
+class IStructureDetailsView;
+class FStructOnScope;
+class SDockTab;
+class FSpawnTabArgs;
+
+/**
+ * Dockable "Hotkey Parameters" tab, used instead of the modal parameter dialog when enabled in the plugin settings.
+ *
+ * Pressing a hotkey shows the parameters of every overload it resolved to, one overload at a time. Pressing it again with
+ * the same overloads, Enter in the tab or the Run button runs them all with these parameters. The details view is created
+ * once and retargeted, and each function keeps its own parameter values between presses.
+ */
+class SCustomEditorHotkeysParameterPanel : public SCompoundWidget
+{
+public:
+	using FFunctionAndUtil = FCustomEditorHotkeysBlutilityExtensions::FFunctionAndUtil;
+
+	SLATE_BEGIN_ARGS(SCustomEditorHotkeysParameterPanel) {}
+	SLATE_END_ARGS()
+
+	static const FName TabName;
+
+	static void RegisterTabSpawner();
+	static void UnregisterTabSpawner();
+
+	/** @return Whether the panel is enabled and any of the overloads takes parameters */
+	static bool ShouldHandleCommand(TArrayView<const FFunctionAndUtil> Functions);
+
+	/**
+	 * Handles a hotkey press: shows the overloads' parameters, or runs them when the tab already shows the same overloads.
+	 * @return The number of overloads that ran.
+	 */
+	static int32 HandleCommand(TArrayView<const FFunctionAndUtil> Functions);
+
+	void Construct(const FArguments& InArgs);
+
+	//~ SWidget interface
+	virtual bool SupportsKeyboardFocus() const override { return true; }
+	virtual FReply OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent) override;
+
+private:
+	struct FShownFunction
+	{
+		TWeakObjectPtr<UFunction> Function;
+		TWeakObjectPtr<UObject> Util;
+	};
+
+	static TSharedRef<SDockTab> SpawnTab(const FSpawnTabArgs& Args);
+
+	void SetFunctions(TArrayView<const FFunctionAndUtil> Functions);
+	bool IsShowing(TArrayView<const FFunctionAndUtil> Functions) const;
+	void ShowFunction(int32 Index);
+	void ShowNextFunction();
+	int32 RunFunctions();
+
+	FText GetTitleText() const;
+
+private:
+	TSharedPtr<IStructureDetailsView> DetailsView;
+
+	/** Every overload the last press resolved to, in dispatch order */
+	TArray<FShownFunction> ShownFunctions;
+
+	/** Overload whose parameters are in the details view */
+	int32 ShownIndex = INDEX_NONE;
+
+	static TWeakPtr<SCustomEditorHotkeysParameterPanel> ActivePanel;
+};